@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+// ---- 粒子プール（空きリスト＋生存リスト）----
+// alloc / release とも O(1)。release は生存リストの末尾と入れ替えるので、
+// 走査しながら消すときは末尾から回す
+// Arduino に依存しないので native 環境のテスト（test/native）からもそのまま使う
+template <int N>
+struct ParticlePool {
+  uint16_t freeList[N];
+  uint16_t freeTop;
+  uint16_t alive[N];     // 生存スロット（先頭 count 個が有効）
+  uint16_t aliveAt[N];   // スロット → alive 内の位置
+  uint16_t count;
+
+  void init() {
+    for (int i = 0; i < N; i++) freeList[i] = N - 1 - i;
+    freeTop = N;
+    count = 0;
+  }
+
+  int alloc() {
+    if (freeTop == 0) return -1;
+    uint16_t slot = freeList[--freeTop];
+    aliveAt[slot] = count;
+    alive[count++] = slot;
+    return slot;
+  }
+
+  void release(uint16_t slot) {
+    uint16_t at   = aliveAt[slot];
+    uint16_t last = alive[--count];
+    alive[at] = last;
+    aliveAt[last] = at;
+    freeList[freeTop++] = slot;
+  }
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+// ==== 固定小数点投影 ====
+// 座標は Q16（1.0 = 65536）。fov / z は z を 1/512 刻みにした表から
+// 線形補間で引くので、投影に割り算は出てこない
+// Arduino に依存しないので native 環境のテスト（test/native）からもそのまま使う
+static const float   PROJ_FOV  = 0.65f;                    // drawStarsWarp() と同じ
+static const int     RZ_SHIFT  = 7;                        // Q16 の z → 表の添字
+static const int32_t RZ_MIN_Q  = (int32_t)(0.04f * 65536); // これより手前は打ち切り
+static const int32_t RZ_MAX_Q  = 2 << 16;                  // z = 0..2 を表に持つ
+static const int     RZ_SIZE   = (RZ_MAX_Q >> RZ_SHIFT) + 1;
+
+static int32_t recipZLut[RZ_SIZE];   // fov / z（Q16）
+
+static inline int32_t toQ16(float v) {
+  return (int32_t)(v * 65536.0f);
+}
+
+// 各点は格子上の z の真値で持つ（RZ_MIN_Q を挟む区間も補間が崩れない）。
+// z = 0 の 0 番は参照されないので 1 番と同じ値を入れておく
+static inline void initRecipZTable() {
+  for (int i = 0; i < RZ_SIZE; i++) {
+    int32_t zq = (i > 0 ? i : 1) << RZ_SHIFT;
+    recipZLut[i] = (int32_t)(PROJ_FOV / (zq / 65536.0f) * 65536.0f + 0.5f);
+  }
+}
+
+// fov / z（z, 戻り値とも Q16）
+static inline int32_t recipZ(int32_t zq) {
+  if (zq < RZ_MIN_Q) zq = RZ_MIN_Q;
+  if (zq >= RZ_MAX_Q) zq = RZ_MAX_Q - 1;
+  int32_t idx  = zq >> RZ_SHIFT;
+  int32_t frac = zq & ((1 << RZ_SHIFT) - 1);
+  int32_t a = recipZLut[idx];
+  int32_t b = recipZLut[idx + 1];
+  return a + (((b - a) * frac) >> RZ_SHIFT);   // z大＝奥→inv小＝中心へ寄る
+}
+
+// 正規化座標 → 画面座標（Q16）。rq は recipZ() の値
+static inline void projectQ16(int32_t xq, int32_t yq, int32_t rq,
+                              int32_t cxq, int32_t cyq,
+                              int32_t &sxq, int32_t &syq) {
+  sxq = cxq + (int32_t)(((int64_t)xq * rq) >> 16) * 160;
+  syq = cyq + (int32_t)(((int64_t)yq * rq) >> 16) * 120;
+}
@@ -10,10 +10,15 @@
 #define SOL_HDR 0xA5
 
 #define SOL_CMD_ENT 0x0D
+#define SOL_CMD_LATENCY 0x4C   // 'L' 遅延ヒストグラムをシリアルへ
 
 // ==== コア分離 ====
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <esp_timer.h>
+
+#include "ParticlePool.h"
+#include "ProjectionQ16.h"
 
 QueueHandle_t audioQueue;
 
@@ -126,8 +131,39 @@ float   toneBase    = 4000.0f;  // UIで3500〜7000の範囲
 uint8_t soundVolume = 150;       // ソレノイド音量(🔴スピーカー保護のリミッターMAX80)
 bool soundEnabled = true;
 
-// ==== サウンドバッファ ====
-static int16_t clickBuffer[200];
+// ==== クリック音バンク ====
+// toneBase が変わった時だけ全種類を作り直し、発火時はポインタを渡すだけ
+// 再生中の波形を書き換えないよう 2面持ちで、作り直しは裏面に書いてから切り替える
+enum ClickKind : uint8_t {
+  CLICK_LIGHT = 0,
+  CLICK_STRONG,
+  CLICK_MISSILE,
+  CLICK_KIND_COUNT
+};
+
+const int   CLICK_SAMPLE_RATE = 16000;
+const int   CLICK_MAX_SAMPLES = 320;
+const int   CLICK_VARIANTS    = 4;   // ピッチ揺らぎ違い
+const float CLICK_JITTER[CLICK_VARIANTS] = { 1.000f, 0.975f, 1.020f, 0.990f };
+
+struct ClickShape {
+  float pitch;     // toneBase に対する倍率
+  float lowFreq;   // 胴鳴り
+  float mix;       // 胴鳴りの混ぜ具合
+  float decay;     // 1サンプルごとの減衰
+  float gain;
+  int   samples;
+};
+
+const ClickShape CLICK_SHAPES[CLICK_KIND_COUNT] = {
+  { 1.00f, 250.0f, 0.30f, 0.9980f, 0.75f, 160 },  // LIGHT（従来のクリック）
+  { 0.90f, 200.0f, 0.45f, 0.9985f, 0.75f, 200 },  // STRONG
+  { 0.60f, 120.0f, 0.70f, 0.9990f, 0.60f, 320 },  // MISSILE
+};
+
+static int16_t clickBank[2][CLICK_KIND_COUNT][CLICK_VARIANTS][CLICK_MAX_SAMPLES];
+static volatile uint8_t clickBankFront = 0;
+static float clickBankTone = 0.0f;          // 0 = 未生成
 
 // ==== 直近の発火時刻（ms）…高速連打判定用 ====
 uint32_t lastFireMs = 0;
@@ -175,88 +211,474 @@ void loadConfig() {
 
 
 // ======================================================
-// 金属クリック波形生成
+// 金属クリック波形生成（バンク作成時だけ）
 // ======================================================
-void makeClickWave() {
-  const int   sampleRate = 16000;
-  const float baseFreq   = constrain(toneBase, 3500.0f, 7000.0f);  // 安全レンジ
-  const float decay      = 0.998f;
-  const float lowFreq    = 250.0f;
-  const float mix        = 0.30f;
-  const int   samples    = 160;
+void makeClickWave(int16_t* dst, const ClickShape& sh, float freq) {
+  const float w1 = 2.0f * PI * freq       / CLICK_SAMPLE_RATE;
+  const float w2 = 2.0f * PI * sh.lowFreq / CLICK_SAMPLE_RATE;
 
+  float env = 1.0f;
   float phase1 = 0.0f, phase2 = 0.0f;
-  for (int i = 0; i < samples; i++) {
-    float env = powf(decay, i);
-    float sig = sinf(phase1) * env + sinf(phase2) * env * mix;
-    clickBuffer[i] = (int16_t)(sig * 30000);
-    phase1 += 2.0f * PI * baseFreq / sampleRate;
-    phase2 += 2.0f * PI * lowFreq  / sampleRate;
+  for (int i = 0; i < sh.samples; i++) {
+    float sig = (sinf(phase1) + sinf(phase2) * sh.mix) * env * sh.gain;
+    dst[i] = (int16_t)constrain(sig * 30000.0f, -32767.0f, 32767.0f);
+    env    *= sh.decay;
+    phase1 += w1;
+    phase2 += w2;
+  }
+}
+
+void rebuildClickBank() {
+  const float baseFreq = constrain(toneBase, 3500.0f, 7000.0f);  // 安全レンジ
+  uint8_t back = clickBankFront ^ 1;
+
+  for (int k = 0; k < CLICK_KIND_COUNT; k++) {
+    for (int v = 0; v < CLICK_VARIANTS; v++) {
+      makeClickWave(clickBank[back][k][v], CLICK_SHAPES[k],
+                    baseFreq * CLICK_SHAPES[k].pitch * CLICK_JITTER[v]);
+    }
+  }
+
+  clickBankTone  = toneBase;
+  clickBankFront = back;
+}
+
+// ======================================================
+// 受信→出力の遅延計測
+// ======================================================
+// 受信時に esp_timer で刻んだ時刻から、音が出る（ハプティクスが動く）までを
+// 2倍刻みのバケットに数える。シリアルで A5 4C（または 'L'）を送ると出力
+static inline uint32_t nowUs() {
+  return (uint32_t)esp_timer_get_time();
+}
+
+const int LAT_BUCKETS = 9;   // <250us, <500us, <1ms ... <32ms, それ以上
+const uint32_t LAT_BUCKET0_US = 250;
+
+struct LatHist {
+  uint32_t bucket[LAT_BUCKETS];
+  uint32_t count;
+  uint32_t maxUs;
+  uint64_t sumUs;
+};
+
+static LatHist latAudio = {};    // 受信 → クリック音の先頭が DAC に出る（推定）
+static LatHist latHaptic = {};   // 受信 → バイブ ON
+
+void latRecord(LatHist& h, uint32_t us) {
+  int b = 0;
+  uint32_t edge = LAT_BUCKET0_US;
+  while (b < LAT_BUCKETS - 1 && us >= edge) {
+    edge <<= 1;
+    b++;
+  }
+  h.bucket[b]++;
+  h.count++;
+  h.sumUs += us;
+  if (us > h.maxUs) h.maxUs = us;
+}
+
+void latPrint(Stream& out, const char* name, const LatHist& h) {
+  out.printf("[LAT] %s n=%lu avg=%luus max=%luus\n", name,
+             (unsigned long)h.count,
+             (unsigned long)(h.count ? h.sumUs / h.count : 0),
+             (unsigned long)h.maxUs);
+  uint32_t edge = LAT_BUCKET0_US;
+  for (int b = 0; b < LAT_BUCKETS; b++) {
+    if (b < LAT_BUCKETS - 1) out.printf("  <%5luus %lu\n", (unsigned long)edge, (unsigned long)h.bucket[b]);
+    else                     out.printf("  >=%4luus %lu\n", (unsigned long)(edge >> 1), (unsigned long)h.bucket[b]);
+    edge <<= 1;
   }
 }
 
 // ======================================================
 // 音再生（非ブロッキング）
 // ======================================================
-inline void playClick()
+struct AudioEvt {
+  uint8_t  kind;
+  uint32_t rxUs;   // 受信時刻（0 = 計測しない）
+  uint32_t atUs;   // 鳴らしたい時刻（0 = すぐ）
+};
+
+inline void playClick(ClickKind kind = CLICK_LIGHT, uint32_t rxUs = 0, uint32_t atUs = 0)
 {
     if (!soundEnabled) return;   // ★追加
 
-    uint8_t evt = 1;
+    AudioEvt evt = { (uint8_t)kind, rxUs, atUs };
     xQueueSend(audioQueue, &evt, 0);
 }
 
+// ======================================================
+// ミキサー
+// ======================================================
+// クリックを 1本ずつ playRaw すると連打で前の音が切れるので、
+// N ボイスを整数で足し合わせた 3ms ブロックを 1チャンネルに流し続ける。
+// 従来の playRaw(stereo=true) と同じ鳴り方になるよう、
+// 16kHz で作った波形を 1サンプル/出力サンプルで 32kHz モノラルとして出す
+const int     MIX_VOICES  = 6;
+const int     MIX_RATE    = CLICK_SAMPLE_RATE * 2;
+const int     MIX_BLOCK   = MIX_RATE * 3 / 1000;   // 3ms = 96 samples
+const int     MIX_BUFFERS = 3;                     // Speaker 側が 2本抱えるので +1
+const uint8_t MIX_CHANNEL = 1;
+
+struct MixVoice {
+  const int16_t* data;
+  uint16_t len;
+  uint16_t pos;
+  uint32_t delay;   // 鳴り始めまでの無音サンプル数（予約発音）
+  uint32_t rxUs;    // 遅延計測用（0 = 計測しない）
+  uint8_t  bank;
+  bool     active;
+};
+
+struct MixStats {
+  uint32_t started;
+  uint32_t stolen;
+  uint32_t clipped;     // 飽和したサンプル数
+  uint32_t blocks;
+  uint8_t  peakVoices;
+};
+
+static MixVoice mixVoices[MIX_VOICES];
+static int16_t  mixOut[MIX_BUFFERS][MIX_BLOCK];
+static volatile MixStats mixStats = {};
+
+bool clickBankInUse(uint8_t bank) {
+  for (int i = 0; i < MIX_VOICES; i++) {
+    if (mixVoices[i].active && mixVoices[i].bank == bank) return true;
+  }
+  return false;
+}
+
+// 空きが無ければ一番進んでいる（=もうすぐ消える）ボイスを奪う
+void startVoice(const AudioEvt& evt, uint8_t variant) {
+  uint8_t kind = evt.kind;
+  int slot = -1;
+  int best = -1;
+  for (int i = 0; i < MIX_VOICES; i++) {
+    if (!mixVoices[i].active) { slot = i; break; }
+    if (mixVoices[i].pos > best) { best = mixVoices[i].pos; slot = i; }
+  }
+  if (mixVoices[slot].active) mixStats.stolen++;
+
+  uint8_t bank = clickBankFront;
+  mixVoices[slot].data   = clickBank[bank][kind][variant];
+  mixVoices[slot].len    = CLICK_SHAPES[kind].samples;
+  mixVoices[slot].pos    = 0;
+  mixVoices[slot].rxUs   = evt.rxUs;
+  mixVoices[slot].bank   = bank;
+
+  // 予約時刻までの残りをサンプル数に直す（過ぎていれば即時）
+  int32_t lead = evt.atUs ? (int32_t)(evt.atUs - nowUs()) : 0;
+  mixVoices[slot].delay = (lead > 0) ? (uint32_t)((int64_t)lead * MIX_RATE / 1000000) : 0;
+
+  mixVoices[slot].active = true;
+  mixStats.started++;
+}
+
+// 1ブロック分を合成。鳴っているボイス数を返す
+// outUs: このブロックの先頭が DAC に出る見込み時刻
+int mixBlock(int16_t* out, uint32_t outUs) {
+  int32_t acc[MIX_BLOCK] = {};
+  int voices = 0;
+
+  for (int v = 0; v < MIX_VOICES; v++) {
+    MixVoice& mv = mixVoices[v];
+    if (!mv.active) continue;
+    voices++;
+
+    if (mv.delay >= MIX_BLOCK) {
+      mv.delay -= MIX_BLOCK;
+      continue;
+    }
+
+    int start = mv.delay;
+    mv.delay = 0;
+    if (mv.pos == 0 && mv.rxUs != 0) {
+      latRecord(latAudio, outUs + start * 1000000 / MIX_RATE - mv.rxUs);
+    }
+
+    int n = min(MIX_BLOCK - start, mv.len - mv.pos);
+    const int16_t* src = mv.data + mv.pos;
+    int32_t* dst = acc + start;
+    for (int i = 0; i < n; i++) dst[i] += src[i];
+
+    mv.pos += n;
+    if (mv.pos >= mv.len) mv.active = false;
+  }
+
+  uint32_t clipped = 0;
+  for (int i = 0; i < MIX_BLOCK; i++) {
+    int32_t x = acc[i];
+    if (x > 32767)       { x = 32767;  clipped++; }
+    else if (x < -32768) { x = -32768; clipped++; }
+    out[i] = (int16_t)x;
+  }
+
+  mixStats.clipped += clipped;
+  mixStats.blocks++;
+  if (voices > mixStats.peakVoices) mixStats.peakVoices = voices;
+  return voices;
+}
+
+bool mixIdle() {
+  for (int i = 0; i < MIX_VOICES; i++) {
+    if (mixVoices[i].active) return false;
+  }
+  return true;
+}
+
 // ======================================================
 // 音タスク（コア分離用）
 // ======================================================
 void audioTask(void* arg)
 {
-    uint8_t evt;
+    AudioEvt evt;
+    uint8_t variant = 0;
+    uint8_t outIdx = 0;
+
+    rebuildClickBank();
 
     while (1)
     {
-        if (xQueueReceive(audioQueue, &evt, portMAX_DELAY))
+        // 無音中は次のクリックまで寝る。暇な時に設定変更を反映しておく
+        if (mixIdle())
         {
-            if (evt == 1)   // click
+            if (!xQueueReceive(audioQueue, &evt, pdMS_TO_TICKS(100)))
             {
-                makeClickWave();
-                M5.Speaker.playRaw(
-                    clickBuffer,
-                    sizeof(clickBuffer)/sizeof(int16_t),
-                    16000,
-                    true,
-                    1
-                );
+                if (clickBankTone != toneBase) rebuildClickBank();
+                continue;
+            }
+            // スライダー操作直後のクリックは新しい音で鳴らす
+            if (clickBankTone != toneBase) rebuildClickBank();
+            if (evt.kind < CLICK_KIND_COUNT)
+            {
+                variant = (variant + 1) % CLICK_VARIANTS;
+                startVoice(evt, variant);
             }
         }
+
+        // 再生中＋予約の 2本が埋まっている間は待つ（これがブロック周期になる）
+        size_t queued;
+        while ((queued = M5.Speaker.isPlaying(MIX_CHANNEL)) >= 2) vTaskDelay(1);
+
+        // 鳴っている間に来たクリックは次のブロック頭から重ねる
+        while (xQueueReceive(audioQueue, &evt, 0))
+        {
+            if (evt.kind >= CLICK_KIND_COUNT) continue;
+            if (clickBankTone != toneBase && !clickBankInUse(clickBankFront ^ 1))
+                rebuildClickBank();
+            variant = (variant + 1) % CLICK_VARIANTS;
+            startVoice(evt, variant);
+        }
+
+        mixBlock(mixOut[outIdx], nowUs() + queued * (MIX_BLOCK * 1000000 / MIX_RATE));
+        M5.Speaker.playRaw(
+            mixOut[outIdx],
+            MIX_BLOCK,
+            MIX_RATE,
+            false,
+            1,
+            MIX_CHANNEL,
+            false
+        );
+        outIdx = (outIdx + 1) % MIX_BUFFERS;
     }
 }
 
 // ======================================================
 // バイブレーション
 // ======================================================
-// ---- Vibration pulse (non-blocking) ----
-static bool     vibPulsing = false;
-static uint32_t vibOffAtUs = 0;
+// ---- Haptic 波形エンジン ----
+// 立ち上がり（過駆動）→ 保持 → ブレーキ（0 で止める）の段階表を esp_timer で進める。
+// モーター電圧の I2C 書き込みは hapticTask だけが行い、タイマーは次の段の依頼を積むだけ
+struct HapticStep {
+  uint8_t gain;   // vibStrength に対する %（100 = 設定値、0 = 停止）
+  uint8_t ms;
+};
 
-inline void startVibrationPulseUs(uint32_t duration_us) {
-  if (!vibEnabled) return;
-  M5.Power.setVibration(vibStrength);
-  vibPulsing = true;
-  vibOffAtUs = micros() + duration_us;
-}
+const HapticStep HAP_WAVE_LIGHT[]   = { {160,  6}, {100, 22}, {  0,  8} };
+const HapticStep HAP_WAVE_STRONG[]  = { {200,  8}, {100, 32}, { 40,  6}, {0, 10} };
+const HapticStep HAP_WAVE_MISSILE[] = { {200, 10}, {100, 60}, { 60, 30}, {0, 15} };
+
+struct HapticWave {
+  const HapticStep* steps;
+  uint8_t count;
+};
+
+const HapticWave HAPTIC_WAVES[CLICK_KIND_COUNT] = {
+  { HAP_WAVE_LIGHT,   sizeof(HAP_WAVE_LIGHT)   / sizeof(HapticStep) },
+  { HAP_WAVE_STRONG,  sizeof(HAP_WAVE_STRONG)  / sizeof(HapticStep) },
+  { HAP_WAVE_MISSILE, sizeof(HAP_WAVE_MISSILE) / sizeof(HapticStep) },
+};
+
+// 打鍵間隔が波形より短くなったら、立ち上がり以外を縮めて次の打鍵までに止める
+const uint16_t HAP_MIN_SCALE = 350;   // ‰
+
+enum HapticCmdType : uint8_t { HAP_PLAY = 0, HAP_STEP };
+
+struct HapticCmd {
+  uint8_t  type;
+  uint8_t  kind;      // HAP_PLAY: ClickKind
+  bool     primary;   // 打鍵そのもの（2段目クリックは false）
+  uint32_t arg;       // HAP_PLAY: 受信時刻 / HAP_STEP: 世代番号
+};
+
+struct PulseStats {
+  uint32_t count;       // 段の切り替わり回数
+  uint32_t maxErrUs;
+  uint64_t sumErrUs;
+  int32_t  lastErrUs;   // 実測 − 予定
+  uint32_t retriggers;  // 波形の途中で次が来た回数
+  uint32_t lostSteps;   // 段送りが届かず見張りで進めた回数
+};
+
+// 段送りがこれだけ遅れたら取りこぼしとみなして task 側で進める
+// （オーバードライブ段のまま止まるのを防ぐ）
+const uint32_t HAP_STEP_WATCHDOG_US = 3000;
+
+static QueueHandle_t      hapticQueue = nullptr;
+static esp_timer_handle_t hapticStepTimer = nullptr;
+static volatile uint32_t  hapticGen   = 0;     // 再トリガで古い段送りを無視する
+static volatile uint32_t  hapticArmedGen = 0;  // タイマーをアームした時点の世代
+static PulseStats         vibPulseStats = {};
+
+// 発火時の hapticGen ではなく、アームした世代を返す（再トリガ後の古い段送りを弾ける）
+// 段送りは時刻が命なので先頭に積む。それでも溢れたら hapticTask の見張りが拾う
+void hapticStepTimerCb(void* arg) {
+  HapticCmd c = { HAP_STEP, 0, false, hapticArmedGen };
+  xQueueSendToFront(hapticQueue, &c, 0);
+}
+
+uint32_t hapticWaveUs(const HapticWave& w) {
+  uint32_t us = 0;
+  for (uint8_t i = 0; i < w.count; i++) us += w.steps[i].ms * 1000;
+  return us;
+}
+
+void hapticTask(void* arg) {
+  HapticCmd c;
+  const HapticWave* wave = nullptr;
+  uint8_t  step      = 0;
+  uint8_t  level     = 0;       // 今書いてある値（同じ値は書かない）
+  uint32_t plannedUs = 0;       // 今の段が終わる予定時刻
+  uint16_t scale     = 1000;    // ‰
+  uint32_t lastPrimaryUs = 0;
+  uint32_t avgIntervalUs = 0;
+
+  auto writeLevel = [&](uint8_t v) {
+    if (v == level) return;
+    M5.Power.setVibration(v);
+    level = v;
+  };
+
+  // 段を出力して次の段送りを予約（予定時刻基準なのでずれが積もらない）
+  auto applyStep = [&]() {
+    const HapticStep& st = wave->steps[step];
+    writeLevel(min(255, vibStrength * st.gain / 100));
+
+    uint32_t dur = st.ms * 1000;
+    if (step > 0) dur = dur * scale / 1000;
+    plannedUs += dur;
+
+    int32_t wait = (int32_t)(plannedUs - nowUs());
+    hapticArmedGen = hapticGen;
+    esp_timer_start_once(hapticStepTimer, wait > 100 ? wait : 100);
+  };
+
+  while (1) {
+    // 鳴動中は「予定 + 見張り時間」までしか待たない
+    TickType_t waitTicks = portMAX_DELAY;
+    if (wave != nullptr) {
+      int32_t left = (int32_t)(plannedUs + HAP_STEP_WATCHDOG_US - nowUs());
+      waitTicks = left > 0 ? pdMS_TO_TICKS(left / 1000) + 1 : 0;
+    }
+
+    if (!xQueueReceive(hapticQueue, &c, waitTicks)) {
+      if (wave == nullptr) continue;
+      if ((int32_t)(nowUs() - plannedUs) < (int32_t)HAP_STEP_WATCHDOG_US) continue;
+      // 段送りを取りこぼした。遅れて届く分は世代を進めて無効にし、ここで次の段へ
+      vibPulseStats.lostSteps++;
+      esp_timer_stop(hapticStepTimer);
+      hapticGen++;
+      c = { HAP_STEP, 0, false, hapticGen };
+    }
+
+    if (c.type == HAP_STEP) {
+      if (wave == nullptr || c.arg != hapticGen) continue;
+      // 停止と入れ違いで走った古いコールバックが新しい世代を拾った場合、
+      // 予定時刻より前に届く。本物の段送りはまだアーム中なので捨ててよい
+      if ((int32_t)(nowUs() - plannedUs) < 0) continue;
+
+      int32_t err = (int32_t)(nowUs() - plannedUs);
+      uint32_t absErr = (err < 0) ? -err : err;
+      vibPulseStats.count++;
+      vibPulseStats.sumErrUs += absErr;
+      vibPulseStats.lastErrUs = err;
+      if (absErr > vibPulseStats.maxErrUs) vibPulseStats.maxErrUs = absErr;
+
+      if (++step >= wave->count) {
+        writeLevel(0);
+        wave = nullptr;
+        continue;
+      }
+      applyStep();
+      continue;
+    }
+
+    // HAP_PLAY
+    if (!vibEnabled || c.kind >= CLICK_KIND_COUNT) continue;
+
+    uint32_t now = nowUs();
+    const HapticWave& w = HAPTIC_WAVES[c.kind];
+
+    if (c.primary) {
+      uint32_t interval = now - lastPrimaryUs;
+      lastPrimaryUs = now;
+      if (interval < 1000000) {
+        avgIntervalUs = avgIntervalUs ? (avgIntervalUs * 3 + interval) / 4 : interval;
+      } else {
+        avgIntervalUs = 0;
+      }
 
-inline void updateVibrationPulse() {
-  if (!vibPulsing) return;
-  // micros() はオーバーフローするけど差分判定ならOK
-  if ((int32_t)(micros() - vibOffAtUs) >= 0) {
-    M5.Power.setVibration(0);
-    vibPulsing = false;
+      uint32_t total = hapticWaveUs(w);
+      scale = 1000;
+      if (avgIntervalUs != 0 && avgIntervalUs < total) {
+        scale = max<uint32_t>(HAP_MIN_SCALE, (uint64_t)avgIntervalUs * 800 / total);
+      }
+    }
+
+    // 鳴動中でも立ち上がりからやり直す（次の打鍵を飲み込まない）
+    // 2段目クリックは自分の波形への重ね打ちなので再トリガに数えない
+    if (wave != nullptr && c.primary) vibPulseStats.retriggers++;
+    esp_timer_stop(hapticStepTimer);
+    hapticGen++;
+
+    wave      = &w;
+    step      = 0;
+    plannedUs = now;
+    applyStep();
+
+    if (c.arg != 0) latRecord(latHaptic, nowUs() - c.arg);
   }
 }
 
-inline void pulseVibrationFast() {
-  startVibrationPulseUs(45000); 
+void initHaptics() {
+  hapticQueue = xQueueCreate(8, sizeof(HapticCmd));
+
+  esp_timer_create_args_t args = {};
+  args.callback = hapticStepTimerCb;
+  args.name     = "hapStep";
+  esp_timer_create(&args, &hapticStepTimer);
+
+  xTaskCreatePinnedToCore(hapticTask, "haptic", 3072, NULL, 4, NULL, 1);
+}
+
+// 打鍵 1回分の波形を鳴らす。primary=false は 2段目クリック（間隔計測に含めない）
+inline void hapticPlay(ClickKind kind, uint32_t rxUs = 0, bool primary = true) {
+  if (!vibEnabled || !hapticQueue) return;
+  HapticCmd c = { HAP_PLAY, (uint8_t)kind, primary, rxUs };
+  xQueueSend(hapticQueue, &c, 0);
 }
 
 // ======================================================
@@ -335,94 +757,132 @@ enum SolenoidState {
   SOL_STATE_FAST_CLICK2,
 };
 
-SolenoidState solState      = SOL_STATE_IDLE;
-int           solPos        = 0;         // 0 ～ 15
-uint32_t      solLastStepMs = 0;
+// 進行は esp_timer のコールバックが持つ。loop は solPos が動いた時に描くだけ
+// solState / solPos / solClickKind を書くのはコールバックだけ。
+// 開始側は solReq に要求を置いてタイマーを即時発火させ、コールバックが取り込む
+// （esp_timer_stop は実行中のコールバックを待たないため、状態を直接書くと競合する）
+volatile SolenoidState solState = SOL_STATE_IDLE;
+volatile int           solPos   = 0;     // 0 ～ 15
+volatile bool          solPosDirty = false;
+static esp_timer_handle_t solTimer = nullptr;
 
 // パラメータ
-const int SOL_NORMAL_STEP_INTERVAL_MS = 5;   // ピストン1ステップ(描画)の間隔
-const int SOL_FAST_GAP_MS             = 17;  // 2段クリック間のギャップ
-const int FAST_THRESHOLD_MS           = 30;  // これより短い間隔なら FAST モード
-
-// NORMAL モード開始（ピストンアニメ＋2段目クリック）
-void startNormalSolenoid() {
-  solPos  = 0;
-  drawSolenoid(solPos);
-  solState      = SOL_STATE_NORMAL_FORWARD;
-  solLastStepMs = millis();
-}
-
-// FAST モード開始（音だけ2段クリック / 描画なし）
-void startFastSolenoid() {
-  // 1発目を即時鳴らす
-  playClick();
-  pulseVibrationFast();
-  solState      = SOL_STATE_FAST_CLICK1;
-  solLastStepMs = millis();
-}
-
-// ステートマシン更新（loop() から毎フレーム呼ぶ）
-void updateSolenoid() {
-  uint32_t now = millis();
+const int SOL_NORMAL_STEP_US = 5000;    // ピストン1ステップ(描画)の間隔
+const int SOL_NORMAL_STEPS   = 3;       // 奥まで（2段目クリックの位置）
+const int SOL_FAST_GAP_US    = 17000;   // 2段クリック間のギャップ
+const int FAST_THRESHOLD_MS  = 30;      // これより短い間隔なら FAST モード
+
+static ClickKind solClickKind = CLICK_LIGHT;   // 2段目クリックも同じ音
+
+// 開始要求：下位8bit = モード、上位 = ClickKind。1ワードで置くので組が崩れない
+enum SolenoidRequest : uint32_t {
+  SOL_REQ_NONE   = 0,
+  SOL_REQ_NORMAL = 1,
+  SOL_REQ_FAST   = 2,
+};
+volatile uint32_t solReq = SOL_REQ_NONE;
+
+void postSolenoidRequest(SolenoidRequest mode, ClickKind kind) {
+  __sync_synchronize();
+  solReq = (uint32_t)mode | ((uint32_t)kind << 8);
+  __sync_synchronize();
+  // 走行中のコールバックが再アームしていても止めて、要求を即時処理させる。
+  // 逆順（こちらが先にアーム）の場合はコールバック側の再アームが失敗するだけ
+  esp_timer_stop(solTimer);
+  esp_timer_start_once(solTimer, 0);
+}
+
+void solTimerCb(void* arg) {
+  uint32_t req = __sync_lock_test_and_set(&solReq, (uint32_t)SOL_REQ_NONE);
+  if (req != SOL_REQ_NONE) {
+    solClickKind = (ClickKind)(req >> 8);
+    solPos       = 0;
+    solPosDirty  = true;
+    if ((req & 0xFF) == SOL_REQ_NORMAL) {
+      solState = SOL_STATE_NORMAL_FORWARD;
+      esp_timer_start_once(solTimer, SOL_NORMAL_STEP_US);
+    } else {
+      solState = SOL_STATE_FAST_CLICK1;
+      esp_timer_start_once(solTimer, SOL_FAST_GAP_US);
+    }
+    return;
+  }
 
   switch (solState) {
-    case SOL_STATE_IDLE:
-      // 何もしない
-      break;
-
     case SOL_STATE_NORMAL_FORWARD:
-      if (now - solLastStepMs >= SOL_NORMAL_STEP_INTERVAL_MS) {
-        solLastStepMs += SOL_NORMAL_STEP_INTERVAL_MS;
-        solPos += 5;
-        if (solPos >= 15) {
-          solPos = 15;
-          // ピストンが奥に到達したタイミングで 2段目クリック
-          playClick();
-          pulseVibrationFast();
-          solState = SOL_STATE_NORMAL_BACK;
-        }
-        drawSolenoid(solPos);
+      solPos += 5;
+      if (solPos >= 15) {
+        solPos = 15;
+        // ピストンが奥に到達したタイミングで 2段目（音は予約済み）
+        hapticPlay(solClickKind, 0, false);
+        solState = SOL_STATE_NORMAL_BACK;
       }
+      solPosDirty = true;
+      esp_timer_start_once(solTimer, SOL_NORMAL_STEP_US);
       break;
 
     case SOL_STATE_NORMAL_BACK:
-      if (now - solLastStepMs >= SOL_NORMAL_STEP_INTERVAL_MS) {
-        solLastStepMs += SOL_NORMAL_STEP_INTERVAL_MS;
-        solPos -= 5;
-        if (solPos <= 0) {
-          solPos  = 0;
-          solState = SOL_STATE_IDLE;
-        }
-        drawSolenoid(solPos);
+      solPos -= 5;
+      if (solPos <= 0) {
+        solPos   = 0;
+        solState = SOL_STATE_IDLE;
+      } else {
+        esp_timer_start_once(solTimer, SOL_NORMAL_STEP_US);
       }
+      solPosDirty = true;
       break;
 
     case SOL_STATE_FAST_CLICK1:
-      // 1発目 → 10ms 後に2発目
-      if (now - solLastStepMs >= SOL_FAST_GAP_MS) {
-        playClick();
-        pulseVibrationFast();
-        solState      = SOL_STATE_FAST_CLICK2;
-        solLastStepMs = now;
-      }
+      // 2発目の音は予約済み。バイブだけ合わせる
+      hapticPlay(solClickKind, 0, false);
+      solState = SOL_STATE_FAST_CLICK2;
+      esp_timer_start_once(solTimer, SOL_FAST_GAP_US);
       break;
 
     case SOL_STATE_FAST_CLICK2:
-      // 2発目 → 10ms 後に完全終了
-      if (now - solLastStepMs >= SOL_FAST_GAP_MS) {
-        solState = SOL_STATE_IDLE;
-      }
+    default:
+      solState = SOL_STATE_IDLE;
       break;
   }
 }
 
+void initSolenoidTimer() {
+  esp_timer_create_args_t args = {};
+  args.callback = solTimerCb;
+  args.name     = "solStep";
+  esp_timer_create(&args, &solTimer);
+}
+
+// NORMAL モード開始（ピストンアニメ＋2段目クリック）
+void startNormalSolenoid(ClickKind kind = CLICK_LIGHT) {
+  playClick(kind, 0, nowUs() + SOL_NORMAL_STEP_US * SOL_NORMAL_STEPS);
+  postSolenoidRequest(SOL_REQ_NORMAL, kind);
+}
+
+// FAST モード開始（音だけ2段クリック / 描画なし）
+void startFastSolenoid(ClickKind kind = CLICK_LIGHT, uint32_t rxUs = 0) {
+  // 1発目を即時鳴らし、2発目は音タスクに時刻指定で予約しておく
+  playClick(kind, rxUs);
+  playClick(kind, 0, nowUs() + SOL_FAST_GAP_US);
+  hapticPlay(kind, rxUs);
+  postSolenoidRequest(SOL_REQ_FAST, kind);
+}
+
+// ピストン位置が動いていたら描く（loop() から毎フレーム呼ぶ）
+void updateSolenoid() {
+  if (!solPosDirty) return;
+  solPosDirty = false;
+  drawSolenoid(solPos);
+}
+
 // 旧API相当ラッパ（NORMAL モード起動）
-inline void solenoidEffect() {
+// I2C の発火はスケジューラ側で起動するので、ここは通らない
+inline void solenoidEffect(ClickKind kind = CLICK_LIGHT, uint32_t rxUs = 0) {
   // 先行クリック
-  playClick();
-  pulseVibrationFast();
+  playClick(kind, rxUs);
+  hapticPlay(kind, rxUs);
   // ピストンアニメ＋2段目クリック
-  startNormalSolenoid();
+  startNormalSolenoid(kind);
 }
 
 // 設定モード等で使う、音だけ高速2段クリック
@@ -447,17 +907,15 @@ camYawVel   += (random(-100, 101) / 100.0f) * (strong ? 1.4f : 1.0f);
   camPitchTarget = clampf(camPitchTarget, -1.8f, 1.8f);
 }
 
-inline void fireSolenoidByTiming() {
+// scheduled=true: 音・バイブ・ピストンは I2C スケジューラが予定時刻で起動済み。演出だけ適用する
+inline void fireSolenoidByTiming(ClickKind kind = CLICK_LIGHT, uint32_t rxUs = 0, bool scheduled = false) {
 if (currentWeapon != WEAPON_MISSILE)
     currentWeapon = WEAPON_GUN;
   onFireVisualFX(false);
 
-  if (uiTheme == THEME_COCKPIT) {
-      solenoidEffect();
-      return;
-  }
+  if (scheduled) return;
 
-  solenoidEffect();
+  solenoidEffect(kind, rxUs);
 }
 
 // ---- WARNING system ----
@@ -473,62 +931,74 @@ uint16_t hudColor = HUD_NORMAL;
 
 
 
-void drawReticle(float cx, float cy) {
+// ---- 描画先 ----
+// コクピットは帯スプライト単位で描くので、各描画関数は描画先 g と
+// その帯の上端 oy（画面座標）を受け取り、y を oy だけずらして描く
+
+// 帯 [oy, oy+bandH) と y0..y1 が重なるか
+static int cockpitBandH = 240;
+static inline bool bandHit(int oy, int y0, int y1) {
+  return y1 >= oy && y0 < oy + cockpitBandH;
+}
+
+void drawReticle(lgfx::LovyanGFX& g, int oy, float cx, float cy) {
 
   uint16_t c = hudColor;
 
   int r = 18;
+  int y = cy - oy;
 
   // 外円
-  M5.Display.drawCircle(cx, cy, r, c);
+  g.drawCircle(cx, y, r, c);
 
   // 十字
-  M5.Display.drawLine(cx - 26, cy, cx - 8, cy, c);
-  M5.Display.drawLine(cx + 8, cy, cx + 26, cy, c);
-  M5.Display.drawLine(cx, cy - 26, cx, cy - 8, c);
-  M5.Display.drawLine(cx, cy + 8, cx, cy + 26, c);
+  g.drawLine(cx - 26, y, cx - 8, y, c);
+  g.drawLine(cx + 8, y, cx + 26, y, c);
+  g.drawLine(cx, y - 26, cx, y - 8, c);
+  g.drawLine(cx, y + 8, cx, y + 26, c);
 
   // 中央点
-  //M5.Display.fillCircle(cx, cy, 2, c);
+  //g.fillCircle(cx, y, 2, c);
 }
 
-void drawLockOnReticle(float cx, float cy)
+void drawLockOnReticle(lgfx::LovyanGFX& g, int oy, float cx, float cy, bool blinkOn)
 {
-  uint16_t c = M5.Display.color565(255, 80, 0);
+  uint16_t c = g.color565(255, 80, 0);
 
   int r = 22;
+  int y = cy - oy;
 
   // ---- 外側ブレード（四方向）----
   int gap = 12;
 
-  M5.Display.drawLine(cx - r, cy - gap, cx - r, cy - r, c);
-  M5.Display.drawLine(cx - r, cy + gap, cx - r, cy + r, c);
+  g.drawLine(cx - r, y - gap, cx - r, y - r, c);
+  g.drawLine(cx - r, y + gap, cx - r, y + r, c);
 
-  M5.Display.drawLine(cx + r, cy - gap, cx + r, cy - r, c);
-  M5.Display.drawLine(cx + r, cy + gap, cx + r, cy + r, c);
+  g.drawLine(cx + r, y - gap, cx + r, y - r, c);
+  g.drawLine(cx + r, y + gap, cx + r, y + r, c);
 
-  M5.Display.drawLine(cx - gap, cy - r, cx - r, cy - r, c);
-  M5.Display.drawLine(cx + gap, cy - r, cx + r, cy - r, c);
+  g.drawLine(cx - gap, y - r, cx - r, y - r, c);
+  g.drawLine(cx + gap, y - r, cx + r, y - r, c);
 
-  M5.Display.drawLine(cx - gap, cy + r, cx - r, cy + r, c);
-  M5.Display.drawLine(cx + gap, cy + r, cx + r, cy + r, c);
+  g.drawLine(cx - gap, y + r, cx - r, y + r, c);
+  g.drawLine(cx + gap, y + r, cx + r, y + r, c);
 
   // ---- 中央小リング ----
-  M5.Display.drawCircle(cx, cy, 8, c);
+  g.drawCircle(cx, y, 8, c);
 
   // ---- 点滅ロック表示 ----
-  if ((millis() / 200) % 2 == 0)
+  if (blinkOn)
   {
-    M5.Display.setTextSize(1);
-    M5.Display.setTextColor(c);
-    M5.Display.setCursor(cx - 10, cy - 36);
-    M5.Display.print("LOCK");
+    g.setTextSize(1);
+    g.setTextColor(c);
+    g.setCursor(cx - 10, y - 36);
+    g.print("LOCK");
   }
 }
 
 
 
-void drawCompass(float heading)
+void drawCompass(lgfx::LovyanGFX& g, int oy, float heading)
 {
   // ---- ステータスバーの下に配置 ----
   int x = 80;
@@ -536,17 +1006,20 @@ void drawCompass(float heading)
   int y = 54;   // ← ここが重要（50pxより下）
   int h = 22;
 
+  if (!bandHit(oy, y - 6, y + h + 4)) return;
+  y -= oy;
+
   // 部分クリア（コンパス専用エリア）
-  M5.Display.fillRect(x-4, y-4, w+8, h+8, BLACK);
+  g.fillRect(x-4, y-4, w+8, h+8, BLACK);
 
   uint16_t c = hudColor;
   int centerX = x + w/2;
 
   // 中央マーカー
-  M5.Display.fillTriangle(centerX-4, y,
-                          centerX+4, y,
-                          centerX,   y-6,
-                          c);
+  g.fillTriangle(centerX-4, y,
+                 centerX+4, y,
+                 centerX,   y-6,
+                 c);
 
   const int minorStep = 5;
   const int majorStep = 30;
@@ -565,7 +1038,7 @@ void drawCompass(float heading)
     bool major = (v % majorStep == 0);
     int len = major ? 10 : 6;
 
-    M5.Display.drawLine(tx, y + h - len, tx, y + h, c);
+    g.drawLine(tx, y + h - len, tx, y + h, c);
 
     if (major)
     {
@@ -577,70 +1050,132 @@ void drawCompass(float heading)
       else if (deg == 180) label = "S";
       else if (deg == 270) label = "W";
 
-      M5.Display.setTextSize(1);
-      M5.Display.setTextColor(c);
+      g.setTextSize(1);
+      g.setTextColor(c);
 
       if (label)
       {
-        M5.Display.setCursor(tx - 3, y + 2);
-        M5.Display.print(label);
+        g.setCursor(tx - 3, y + 2);
+        g.print(label);
       }
       else
       {
-        M5.Display.setCursor(tx - 6, y + 2);
-        M5.Display.printf("%03d", deg);
+        g.setCursor(tx - 6, y + 2);
+        g.printf("%03d", deg);
       }
     }
   }
 }
 
 // ==== Cockpit scene objects ====
-struct Star {
-  float x;   // -1..+1
-  float y;   // -1..+1
-  float z;   //  0..1  (0に近いほど手前)
-};
-
-struct Bullet {
-  float x, y, z;     // ★ -1..+1, -1..+1,  z: 奥行き（大きいほど奥）
-  float px, py, pz;  // ★前回（トレーサー用）
-  float vx, vy, vz;          // ★奥へ進む速度
-  float speed;      // ← 追加
-  float age;        // ← 追加
-  uint16_t life;
-  uint8_t type; 
-};
-
-struct Explosion {
-  float x, y, z;
-  uint8_t life;
-
-  float sparkVX[6];
-  float sparkVY[6];
-};
-static const int EXP_MAX = 12;
-static Explosion explosions[EXP_MAX];
-
-
-static inline void getVanishingPoint(float &cx, float &cy) {
+// 星・弾・爆発は種類ごとに成分別の配列（SoA）で持つ。
+// 更新・投影は成分ごとにまとめて回し、生きている粒子は ParticlePool の
+// 詰めたインデックス列だけを走査する（空きスロットを毎回なめない）
+// ParticlePool 本体は include/ParticlePool.h（native テストと共用）
+
+// ---- 固定ステップ ----
+// シーンの物理は描画と切り離して 120Hz で進める。描画は前ステップと現ステップの
+// 間を simAlpha で補間するだけなので、描画が 30fps に落ちても動きの速さは変わらない。
+// 元の係数は 60fps の 1フレーム単位で決めてあったので、ステップ単位に換算して使う
+static const int   SIM_HZ        = 120;
+static const int   SIM_STEP_US   = 1000000 / SIM_HZ;
+static const int   SIM_MAX_STEPS = 6;                  // 1フレームで追いつく上限（50ms）
+static const int   SIM_TICKS_60  = SIM_HZ / 60;        // 60fps 1フレーム = 2ステップ
+static const float SIM_DT        = 1.0f / SIM_HZ;
+
+// 「毎フレーム diff * r 寄せる」を 1ステップ分に直す
+static inline float simRate(float r60) {
+  return 1.0f - powf(1.0f - r60, 1.0f / SIM_TICKS_60);
+}
+
+static const float SPARK_GROW   = powf(1.05f, 1.0f / SIM_TICKS_60);
+static const float MISSILE_DAMP = powf(0.90f, 1.0f / SIM_TICKS_60);
+
+static uint32_t simLastUs  = 0;
+static uint32_t simAccumUs = 0;
+static float    simAlpha   = 0.0f;   // 描画時の補間係数（0 = 前ステップ, 1 = 現ステップ）
+static float    prevCamYaw = 0.0f, prevCamPitch = 0.0f;
+
+// ---- 星（数は固定。手前に来たら奥へ再配置）----
+static const int STAR_N = 70;
+static struct {
+  float x[STAR_N];   // -1..+1
+  float y[STAR_N];   // -1..+1
+  float z[STAR_N];   //  0..1  (0に近いほど手前)
+  float px[STAR_N], py[STAR_N], pz[STAR_N];   // 前ステップ（補間用）
+} stars;
+
+// 投影結果（1フレームに1回だけ計算し、各帯から読む）
+static struct {
+  int16_t  sx[STAR_N], sy[STAR_N];   // 現在位置
+  int16_t  px[STAR_N], py[STAR_N];   // 尾の根元
+  uint16_t color[STAR_N];
+  uint16_t n;                        // 画面内の数（先頭から詰めて入れる）
+} starProj;
+
+// ---- 弾 ----
+static const int BULLET_MAX = 256;
+static struct {
+  float x[BULLET_MAX], y[BULLET_MAX], z[BULLET_MAX];     // ★ -1..+1, -1..+1,  z: 奥行き（大きいほど奥）
+  float px[BULLET_MAX], py[BULLET_MAX], pz[BULLET_MAX];  // ★前回（トレーサー用）
+  float vx[BULLET_MAX], vy[BULLET_MAX], vz[BULLET_MAX];  // ★奥へ進む速度
+  float speed[BULLET_MAX];
+  float age[BULLET_MAX];
+  uint16_t life[BULLET_MAX];
+  uint8_t  type[BULLET_MAX];
+} bullets;
+static ParticlePool<BULLET_MAX> bulletPool;
+static uint16_t missileAlive = 0;   // 生存ミサイル数（生成・消滅で増減）
+
+static struct {
+  int16_t x1[BULLET_MAX], y1[BULLET_MAX];   // 前回位置
+  int16_t x2[BULLET_MAX], y2[BULLET_MAX];   // 現在位置
+  uint8_t type[BULLET_MAX];
+  uint16_t n;
+} bulletProj;
+
+// ---- 爆発 ----
+static const int EXP_MAX = 32;
+static const int EXP_SPARKS = 6;
+static const int EXP_LIFE = 20 * SIM_TICKS_60;   // 寿命（ステップ）
+static struct {
+  float x[EXP_MAX], y[EXP_MAX], z[EXP_MAX];
+  uint8_t life[EXP_MAX];
+
+  float sparkVX[EXP_SPARKS][EXP_MAX];
+  float sparkVY[EXP_SPARKS][EXP_MAX];
+} explosions;
+static ParticlePool<EXP_MAX> expPool;
+
+static struct {
+  int16_t  sx[EXP_MAX], sy[EXP_MAX];
+  int16_t  radius[EXP_MAX];
+  uint16_t ringColor[EXP_MAX];
+  int16_t  sparkX[EXP_SPARKS][EXP_MAX];
+  int16_t  sparkY[EXP_SPARKS][EXP_MAX];
+  uint16_t n;
+} expProj;
+
+static inline void vanishingPointAt(float yaw, float pitch, float &cx, float &cy) {
   // drawStarsWarp() と完全に同じ係数にする
-  cx = 160.0f + camYaw * 28.0f;   // ←あなたが使ってる値に合わせて
-  cy = 140.0f + camPitch * 22.0f;
+  cx = 160.0f + yaw * 28.0f;   // ←あなたが使ってる値に合わせて
+  cy = 140.0f + pitch * 22.0f;
 }
 
-static inline void project3(float x, float y, float z, float cx, float cy, float &sx, float &sy) {
-  const float fov = 0.65f;                 // drawStarsWarp() と同じ
-  float inv = fov / z;                     // z大＝奥→inv小＝中心へ寄る
-  sx = cx + x * inv * 160.0f;
-  sy = cy + y * inv * 120.0f;
+static inline void getVanishingPoint(float &cx, float &cy) {
+  vanishingPointAt(camYaw, camPitch, cx, cy);
 }
 
-static const int STAR_N = 70;
-static Star stars[STAR_N];
+// ==== 固定小数点投影 ====
+// recipZ / projectQ16 は include/ProjectionQ16.h（native テストと共用）
+static uint16_t grayRamp[256];        // 明るさ → RGB565
 
-static const int BULLET_MAX = 60;
-static Bullet bullets[BULLET_MAX];
-static int bulletHead = 0;
+void initProjectionTables() {
+  initRecipZTable();
+  for (int v = 0; v < 256; v++) {
+    grayRamp[v] = M5.Display.color565(v, v, v);
+  }
+}
 
 // 任意（HUD傾き等に将来使える）
 static float camBank = 0.0f;
@@ -659,11 +1194,16 @@ void triggerWarning(uint32_t durationMs = 2000)
 
 void respawnStar(int i) {
   // 画面中心から少し散らす（完全中心密集を避ける）
-  stars[i].x = frand(-1.0f, 1.0f);
-  stars[i].y = frand(-1.0f, 1.0f);
+  stars.x[i] = frand(-1.0f, 1.0f);
+  stars.y[i] = frand(-1.0f, 1.0f);
 
   // zは奥に配置（遠い星を多めに）
-  stars[i].z = frand(0.35f, 1.0f);
+  stars.z[i] = frand(0.35f, 1.0f);
+
+  // 再配置した星は補間しない
+  stars.px[i] = stars.x[i];
+  stars.py[i] = stars.y[i];
+  stars.pz[i] = stars.z[i];
 }
 
 // 速度パラメータ（お好みで）
@@ -676,72 +1216,58 @@ void updateStars(float dt) {
   float yawShift   = camYaw   * 0.35f;
   float pitchShift = camPitch * 0.28f;
 
-  for (int i = 0; i < STAR_N; i++) {
-    // 前進：zが減る（近づく）
-    stars[i].z -= warpSpeed * dt;
+  memcpy(stars.px, stars.x, sizeof(stars.x));
+  memcpy(stars.py, stars.y, sizeof(stars.y));
+  memcpy(stars.pz, stars.z, sizeof(stars.z));
 
-    // zが手前に来すぎたら奥に戻す
-    if (stars[i].z <= 0.05f) respawnStar(i);
+  // 前進：zが減る（近づく）
+  float dz = warpSpeed * dt;
+  for (int i = 0; i < STAR_N; i++) stars.z[i] -= dz;
 
-    // 旋回/上昇下降で“進行方向”をずらす
-    // 星自体を少し逆方向へずらすと、視点が向いた感じになる
-    stars[i].x -= yawShift * dt * 0.6f;
-    stars[i].y -= pitchShift * dt * 0.6f;
+  // 旋回/上昇下降で“進行方向”をずらす
+  // 星自体を少し逆方向へずらすと、視点が向いた感じになる
+  float dx = yawShift * dt * 0.6f;
+  float dy = pitchShift * dt * 0.6f;
+  for (int i = 0; i < STAR_N; i++) stars.x[i] -= dx;
+  for (int i = 0; i < STAR_N; i++) stars.y[i] -= dy;
 
-    // 範囲外に出た星は再配置（端で不自然に溜まらない）
-    if (stars[i].x < -1.2f || stars[i].x > 1.2f ||
-        stars[i].y < -1.2f || stars[i].y > 1.2f) {
+  for (int i = 0; i < STAR_N; i++) {
+    // zが手前に来すぎた星・範囲外に出た星は再配置（端で不自然に溜まらない）
+    if (stars.z[i] <= 0.05f ||
+        stars.x[i] < -1.2f || stars.x[i] > 1.2f ||
+        stars.y[i] < -1.2f || stars.y[i] > 1.2f) {
       respawnStar(i);
     }
   }
 }
 
-void drawStarsWarp() {
-  
-  //控え目
-  //float cx = 160.0f + camYaw * 18.0f;
-  //float cy = 120.0f + camPitch * 14.0f;
-  
-  // 例（ダイナミック寄り）
-  float cx = 160.0f + camYaw * 60.0f;
-  float cy = 140.0f + camPitch * 45.0f;
-
-  // 画角（値が小さいほど広角）
-  const float fov = 0.65f;
-
-  for (int i = 0; i < STAR_N; i++) {
-    // zが小さいほど大きく投影される → 外側へ伸びる
-    float inv = fov / stars[i].z;
-
-    float sx = cx + stars[i].x * inv * 160.0f;
-    float sy = cy + stars[i].y * inv * 120.0f;
-
-    // 前フレーム相当の位置を推定して尾を描く（簡易）
-    float inv2 = fov / (stars[i].z + 0.06f);
-    float px = cx + stars[i].x * inv2 * 160.0f;
-    float py = cy + stars[i].y * inv2 * 120.0f;
-
-    // 画面外はスキップ
-   if (sx < 0 || sx >= 320 || sy < 0 || sy >= 240) continue;
-
-    // 明るさ：近いほど明るい
-    float near01 = 1.0f - constrain((stars[i].z - 0.05f) / 0.95f, 0.0f, 1.0f);
-    uint8_t v = (uint8_t)(70 + 185 * near01);
-    uint16_t c = M5.Display.color565(v, v, v);
+void drawStarsWarp(lgfx::LovyanGFX& g, int oy) {
+  for (int i = 0; i < starProj.n; i++) {
+    int sy = starProj.sy[i];
+    int py = starProj.py[i];
+    if (!bandHit(oy, min(py, sy), max(py, sy))) continue;
 
     // 尾（短い線）＋点
-    M5.Display.drawLine((int)px, (int)py, (int)sx, (int)sy, c);
-    M5.Display.drawPixel((int)sx, (int)sy, c);
+    uint16_t c = starProj.color[i];
+    g.drawLine(starProj.px[i], py - oy, starProj.sx[i], sy - oy, c);
+    g.drawPixel(starProj.sx[i], sy - oy, c);
   }
 }
 
 void initCockpitScene() {
+  initProjectionTables();
   for (int i = 0; i < STAR_N; i++) respawnStar(i);
 
-  for (int i = 0; i < BULLET_MAX; i++) bullets[i].life = 0;
+  bulletPool.init();
+  expPool.init();
+  missileAlive = 0;
 
   camYaw = camPitch = 0;
   camYawVel = camPitchVel = 0;
+  prevCamYaw = prevCamPitch = 0;
+  simLastUs  = nowUs();
+  simAccumUs = 0;
+  simAlpha   = 0.0f;
   nextCamEventMs = millis() + 1500;
 }
 
@@ -841,13 +1367,12 @@ void spawnBarrage(uint16_t n) {
   const float spread = 0.050f;      // ★散り（小さいほど真っ直ぐ正面）
 
   // 逆投影で、スクリーン座標→正規化(x,y)に戻す
-  const float fov = 0.65f;
-  float inv0 = fov / z0;
+  float inv0 = PROJ_FOV / z0;
 
   for (uint16_t k = 0; k < n; k++) {
-    Bullet &b = bullets[bulletHead];
-    bulletHead = (bulletHead + 1) % BULLET_MAX;
-    b.type = currentWeapon;
+    int i = bulletPool.alloc();
+    if (i < 0) break;                 // 満杯なら撃ち止め
+    bullets.type[i] = currentWeapon;
 
     bool right = (k & 1);
 
@@ -862,65 +1387,181 @@ void spawnBarrage(uint16_t n) {
     nx += frand(-spread, spread);
     ny += frand(-spread, spread);
 
-    b.x = nx; b.y = ny; b.z = z0;
-    b.px = b.x; b.py = b.y; b.pz = b.z;
+    bullets.x[i] = nx; bullets.y[i] = ny; bullets.z[i] = z0;
+    bullets.px[i] = nx; bullets.py[i] = ny; bullets.pz[i] = z0;
+    bullets.age[i] = 0.0f;
     if (currentWeapon == WEAPON_GUN)
     {
-      b.age   = 0.0f;
-      b.speed = 0.0f;     // 使わないけど初期化して安全に
-      b.vx = 0.0f;
-      b.vy = 0.0f;
-      b.vz = vz * (0.85f + random(0,31)/100.0f);
+      bullets.speed[i] = 0.0f;     // 使わないけど初期化して安全に
+      bullets.vx[i] = 0.0f;
+      bullets.vy[i] = 0.0f;
+      bullets.vz[i] = vz * (0.85f + random(0,31)/100.0f);
 
-      b.life = 26 + random(0, 12);   // 寿命（描画の生死）
+      bullets.life[i] = (26 + random(0, 12)) * SIM_TICKS_60;   // 寿命（ステップ）
     }
     else
     {
       // ---- ミサイル初期挙動 ----
-      b.age   = 0.0f;
-      b.speed = 1.0f;     // 初速
+      bullets.speed[i] = 1.0f;     // 初速
       float side = right ? 0.4f : -0.4f;  // ★ 横広がりは残すが弱め（0.6→0.55）
-      b.vx = side;
-      b.vy = frand(-0.01f, 0.01f);          // ★ 少しだけ上下の“噴かし”
-      b.vz = 1.0f;                          // ★ 前進のベースも上げる
-      b.life = 32 + random(0, 10);          // ★ 少し長めに飛ばす（任意）
+      bullets.vx[i] = side;
+      bullets.vy[i] = frand(-0.01f, 0.01f);          // ★ 少しだけ上下の“噴かし”
+      bullets.vz[i] = 1.0f;                          // ★ 前進のベースも上げる
+      bullets.life[i] = (32 + random(0, 10)) * SIM_TICKS_60;  // ★ 少し長めに飛ばす（任意）
+      missileAlive++;
     }
   }
 }
 
 void spawnExplosion(float x, float y, float z)
 {
-  for (int i = 0; i < EXP_MAX; i++)
-  {
-    if (explosions[i].life == 0)
-    {
-      explosions[i].x = x;
-      explosions[i].y = y;
-      explosions[i].z = z;
-      explosions[i].life = 20;
+  int i = expPool.alloc();
+  if (i < 0) return;
 
-      // 🔥 火花方向ランダム生成
-      for (int s = 0; s < 6; s++)
-      {
-        float ang = frand(0.0f, 2.0f * PI);
-        float spd = frand(0.02f, 0.06f);
-        explosions[i].sparkVX[s] = cosf(ang) * spd;
-        explosions[i].sparkVY[s] = sinf(ang) * spd;
-      }
+  explosions.x[i] = x;
+  explosions.y[i] = y;
+  explosions.z[i] = z;
+  explosions.life[i] = EXP_LIFE;
 
-      break;
-    }
+  // 🔥 火花方向ランダム生成
+  for (int s = 0; s < EXP_SPARKS; s++)
+  {
+    float ang = frand(0.0f, 2.0f * PI);
+    float spd = frand(0.02f, 0.06f);
+    explosions.sparkVX[s][i] = cosf(ang) * spd;
+    explosions.sparkVY[s][i] = sinf(ang) * spd;
   }
 }
 
 bool isExplosionActive()
 {
-  for (int i = 0; i < EXP_MAX; i++)
+  return expPool.count > 0;
+}
+
+// 星・弾・爆発の投影（1フレームに1回まとめて）
+// 位置は前ステップと現ステップの間を a で補間する
+void projectScene(float yaw, float pitch, float cx, float cy, float a) {
+  const int32_t W_Q = 320 << 16;
+  const int32_t H_Q = 240 << 16;
+
+  // ---- 星 ----
   {
-    if (explosions[i].life > 0)
-      return true;
+    //控え目
+    //float scx = 160.0f + camYaw * 18.0f;
+    //float scy = 120.0f + camPitch * 14.0f;
+
+    // 例（ダイナミック寄り）
+    int32_t scx = toQ16(160.0f + yaw * 60.0f);
+    int32_t scy = toQ16(140.0f + pitch * 45.0f);
+
+    const int32_t TAIL_Q  = toQ16(0.06f);
+    const int32_t NEAR_Q  = toQ16(0.05f);
+    const int32_t SPAN_Q  = toQ16(0.95f);
+    const uint32_t SHADE_K = (uint32_t)(185.0f / 0.95f * 256.0f + 0.5f);
+
+    uint16_t n = 0;
+    for (int i = 0; i < STAR_N; i++) {
+      int32_t xq = toQ16(stars.px[i] + (stars.x[i] - stars.px[i]) * a);
+      int32_t yq = toQ16(stars.py[i] + (stars.y[i] - stars.py[i]) * a);
+      int32_t zq = toQ16(stars.pz[i] + (stars.z[i] - stars.pz[i]) * a);
+
+      // zが小さいほど大きく投影される → 外側へ伸びる
+      int32_t sx, sy;
+      projectQ16(xq, yq, recipZ(zq), scx, scy, sx, sy);
+
+      // 画面外はスキップ
+      if (sx < 0 || sx >= W_Q || sy < 0 || sy >= H_Q) continue;
+
+      // 前フレーム相当の位置を推定して尾を描く（簡易）
+      int32_t px, py;
+      projectQ16(xq, yq, recipZ(zq + TAIL_Q), scx, scy, px, py);
+
+      // 明るさ：近いほど明るい（70..255）。185 / 0.95 は Q8 の定数で掛ける
+      uint32_t d = constrain(zq - NEAR_Q, 0, SPAN_Q);
+      uint8_t v = 255 - (uint8_t)((d * SHADE_K) >> 24);
+
+      starProj.sx[n] = sx >> 16;
+      starProj.sy[n] = sy >> 16;
+      starProj.px[n] = px >> 16;
+      starProj.py[n] = py >> 16;
+      starProj.color[n] = grayRamp[v];
+      n++;
+    }
+    starProj.n = n;
+  }
+
+  int32_t cxq = toQ16(cx);
+  int32_t cyq = toQ16(cy);
+
+  // ---- 弾 ----
+  {
+    const int32_t XMIN_Q = -10 << 16, XMAX_Q = 330 << 16;
+    const int32_t YMIN_Q = -10 << 16, YMAX_Q = 230 << 16;
+
+    uint16_t n = 0;
+    for (int k = 0; k < bulletPool.count; k++) {
+      int i = bulletPool.alive[k];
+
+      // 1ステップの移動量。トレーサーの尾は 60fps 1フレーム分の長さにする
+      float dx = bullets.x[i] - bullets.px[i];
+      float dy = bullets.y[i] - bullets.py[i];
+      float dz = bullets.z[i] - bullets.pz[i];
+      float hx = bullets.px[i] + dx * a;
+      float hy = bullets.py[i] + dy * a;
+      float hz = bullets.pz[i] + dz * a;
+
+      int32_t x2, y2;
+      projectQ16(toQ16(hx), toQ16(hy), recipZ(toQ16(hz)), cxq, cyq, x2, y2);
+
+      // 画面内だけ
+      if (x2 < XMIN_Q || x2 > XMAX_Q || y2 < YMIN_Q || y2 > YMAX_Q) continue;
+
+      int32_t x1, y1;
+      projectQ16(toQ16(hx - dx * SIM_TICKS_60), toQ16(hy - dy * SIM_TICKS_60),
+                 recipZ(toQ16(hz - dz * SIM_TICKS_60)), cxq, cyq, x1, y1);
+
+      bulletProj.x1[n] = x1 >> 16;
+      bulletProj.y1[n] = y1 >> 16;
+      bulletProj.x2[n] = x2 >> 16;
+      bulletProj.y2[n] = y2 >> 16;
+      bulletProj.type[n] = bullets.type[i];
+      n++;
+    }
+    bulletProj.n = n;
+  }
+
+  // ---- 爆発 ----
+  {
+    uint16_t n = 0;
+    for (int k = 0; k < expPool.count; k++) {
+      int i = expPool.alive[k];
+
+      int32_t rq = recipZ(toQ16(explosions.z[i]));
+      int32_t sx, sy;
+      projectQ16(toQ16(explosions.x[i]), toQ16(explosions.y[i]), rq, cxq, cyq, sx, sy);
+
+      // 経過は 60fps のフレーム数で数える（係数がその単位なので）
+      float age = (EXP_LIFE - explosions.life[i] + a) / SIM_TICKS_60;
+      uint8_t glow = 255 - (int)(age * 12);
+
+      expProj.sx[n] = sx >> 16;
+      expProj.sy[n] = sy >> 16;
+      expProj.radius[n] = (int16_t)(age * 2.5f);
+      expProj.ringColor[n] = M5.Display.color565(glow, glow/2, 0);
+
+      for (int s = 0; s < EXP_SPARKS; s++)
+      {
+        float px = explosions.x[i] + explosions.sparkVX[s][i] * age;
+        float py = explosions.y[i] + explosions.sparkVY[s][i] * age;
+        int32_t qx, qy;
+        projectQ16(toQ16(px), toQ16(py), rq, cxq, cyq, qx, qy);
+        expProj.sparkX[s][n] = qx >> 16;
+        expProj.sparkY[s][n] = qy >> 16;
+      }
+      n++;
+    }
+    expProj.n = n;
   }
-  return false;
 }
 
 void consumeFXEvents() {
@@ -942,14 +1583,17 @@ else
 }
 }
 
-void drawSpeedTape(float speed)
+void drawSpeedTape(lgfx::LovyanGFX& g, int oy, float speed)
 {
   int x = 13;
   int y = 90;
   int w = 55;
   int h = 130;
 
-  M5.Display.fillRect(x-4, y-4, w+8, h+8, BLACK);
+  if (!bandHit(oy, y - 4, y + h + 4)) return;
+  y -= oy;
+
+  g.fillRect(x-4, y-4, w+8, h+8, BLACK);
 
   uint16_t c = hudColor;
 
@@ -961,6 +1605,7 @@ void drawSpeedTape(float speed)
 
   int base = ((int)speed / minorStep) * minorStep;
 
+  g.setTextColor(c);
   for (int v = base - 400; v <= base + 400; v += minorStep)
   {
     int dy = (speed - v) * pixelPerUnit;
@@ -971,35 +1616,38 @@ void drawSpeedTape(float speed)
     bool major = (v % majorStep == 0);
     int len = major ? 20 : 10;
 
-    M5.Display.drawLine(x + w - len, ty, x + w, ty, c);
+    g.drawLine(x + w - len, ty, x + w, ty, c);
 
     if (major)
     {
-      M5.Display.setTextSize(1);
-      M5.Display.setCursor(x + 4, ty - 4);
-      M5.Display.printf("%d", v);
+      g.setTextSize(1);
+      g.setCursor(x + 4, ty - 4);
+      g.printf("%d", v);
     }
   }
 
   // 中央表示
-  M5.Display.fillRect(x, centerY-12, w, 24, BLACK);
-  M5.Display.drawRect(x, centerY-12, w, 24, c);
+  g.fillRect(x, centerY-12, w, 24, BLACK);
+  g.drawRect(x, centerY-12, w, 24, c);
 
-  M5.Display.setTextSize(2);
-  M5.Display.setCursor(x+15, centerY-8);
-  M5.Display.printf("%d", (int)speed);
+  g.setTextSize(2);
+  g.setCursor(x+15, centerY-8);
+  g.printf("%d", (int)speed);
 }
 
 
-void drawAltTape(int alt)
+void drawAltTape(lgfx::LovyanGFX& g, int oy, int alt)
 {
   int x = 250;
   int y = 90;
   int w = 55;
   int h = 130;
 
+  if (!bandHit(oy, y - 4, y + h + 4)) return;
+  y -= oy;
+
   // ---- 部分クリア（重要）----
-  M5.Display.fillRect(x-4, y-4, w+8, h+8, BLACK);
+  g.fillRect(x-4, y-4, w+8, h+8, BLACK);
 
   uint16_t c = hudColor;
 
@@ -1025,31 +1673,97 @@ void drawAltTape(int alt)
     int len = major ? 20 : 10;
 
     // 左側に目盛り
-    M5.Display.drawLine(x, ty, x + len, ty, c);
+    g.drawLine(x, ty, x + len, ty, c);
 
     if (major)
     {
-      M5.Display.setTextSize(1);
-      M5.Display.setTextColor(c);
-      M5.Display.setCursor(x + 22, ty - 4);
-      M5.Display.printf("%d", v);
+      g.setTextSize(1);
+      g.setTextColor(c);
+      g.setCursor(x + 22, ty - 4);
+      g.printf("%d", v);
     }
   }
 
   // ===== 中央固定ウィンドウ =====
-  M5.Display.fillRect(x, centerY - 12, w, 24, BLACK);
-  M5.Display.drawRect(x, centerY - 12, w, 24, c);
+  g.fillRect(x, centerY - 12, w, 24, BLACK);
+  g.drawRect(x, centerY - 12, w, 24, c);
+
+  g.setTextSize(2);
+  g.setCursor(x + 6, centerY - 8);
+  g.printf("%d", alt);
+}
+
+// ==== コクピット描画 ====
+// 1フレーム分の HUD 状態は先に 1回だけ決め、帯ごとの描画はそれを読むだけにする
+// （帯ごとに millis() を読むと点滅が帯の境目でずれる）
+struct CockpitFrame {
+  float    cx, cy;      // 消失点
+  int      speed;
+  int      alt;
+  float    heading;
+  bool     flash;
+  bool     lockBlink;
+  bool     warnBlink;
+  bool     mslBlink;
+};
 
-  M5.Display.setTextSize(2);
-  M5.Display.setCursor(x + 6, centerY - 8);
-  M5.Display.printf("%d", alt);
+static CockpitFrame cockpitFrame;
+
+// 帯スプライト（2面を交互に使い、片方を DMA 転送中にもう片方へ描く）
+const int COCKPIT_BAND_H = 48;
+const int COCKPIT_BANDS  = 240 / COCKPIT_BAND_H;
+
+static LGFX_Sprite cockpitBand[2] = { LGFX_Sprite(&M5.Display), LGFX_Sprite(&M5.Display) };
+static bool cockpitBandsReady  = false;
+static bool cockpitBandsFailed = false;
+
+// HUD 表示用の計測値
+static uint32_t cockpitSpiUs   = 0;   // 1フレームで SPI 転送待ちに使った時間
+static float    cockpitFps     = 0.0f;
+static uint32_t cockpitFpsFrames = 0;
+static uint32_t cockpitFpsStartMs = 0;
+
+bool ensureCockpitBands() {
+  if (cockpitBandsReady) return true;
+  if (cockpitBandsFailed) return false;
+
+  for (int i = 0; i < 2; i++) {
+    cockpitBand[i].setColorDepth(16);
+    cockpitBand[i].setPsram(false);   // DMA 転送するので内部 RAM
+    if (!cockpitBand[i].createSprite(320, COCKPIT_BAND_H)) {
+      for (int j = 0; j < i; j++) cockpitBand[j].deleteSprite();
+      cockpitBandsFailed = true;      // 以後は直接描画
+      return false;
+    }
+  }
+  cockpitBandsReady = true;
+  return true;
 }
 
-void drawCockpit() {
-  // 背景
-  M5.Display.fillRect(0, 0, 320, 240, BLACK);
+void updateCockpitFrame() {
+  uint32_t nowMs = millis();
+  CockpitFrame& f = cockpitFrame;
+
+  // カメラは前ステップとの間を補間
+  float yaw   = prevCamYaw   + (camYaw   - prevCamYaw)   * simAlpha;
+  float pitch = prevCamPitch + (camPitch - prevCamPitch) * simAlpha;
+
+  vanishingPointAt(yaw, pitch, f.cx, f.cy);
+  projectScene(yaw, pitch, f.cx, f.cy, simAlpha);
 
-  drawStarsWarp();
+  if (lockActive && (int32_t)(nowMs - lockUntilMs) >= 0)
+  {
+      lockActive = false;
+  }
+
+  f.speed = constrain((int)hudSpeed, 200, 1200);
+  f.alt   = constrain((int)hudAlt,   1000, 15000);
+
+  f.heading   = yaw * 90.0f;
+  f.flash     = (int32_t)(nowMs - fxFlashUntilMs) < 0;
+  f.lockBlink = (nowMs / 200) % 2 == 0;
+  f.warnBlink = (nowMs / 200) % 2 == 0;
+  f.mslBlink  = (nowMs / 150) % 2 == 0;
 
   // ステータス（ソースとバッテリをそれっぽく）
   hudSprite.setTextColor(hudColor);
@@ -1066,44 +1780,50 @@ void drawCockpit() {
     (activeSource==SRC_BT)?"BT":
     (activeSource==SRC_I2C)?"I2C":"NONE");
 
+  // 描画性能（前フレームの実測）
+  hudSprite.setCursor(108, 18);
+  hudSprite.printf("FPS:%2d SPI:%4.1fms", (int)(cockpitFps + 0.5f), cockpitSpiUs / 1000.0f);
+
   hudSprite.setCursor(240, 18);
   hudSprite.printf("PWR:%d%%", batteryPct);
   hudSprite.drawRect(10, 10, 300, 25, hudColor);
+}
+
+// 帯 1本分を描く（oy = 帯の上端）
+void renderCockpit(lgfx::LovyanGFX& g, int oy) {
+  const CockpitFrame& f = cockpitFrame;
+
+  drawStarsWarp(g, oy);
 
-  // 最後に一括転送
-  hudSprite.pushSprite(0, 0);
+  // ステータスバー
+  if (bandHit(oy, 0, 49)) hudSprite.pushSprite(&g, 0, -oy);
 
 // 弾（正面奥へ：投影トレーサー）
 {
-  float cx, cy;
-  getVanishingPoint(cx, cy);
-
-  for (int i = 0; i < BULLET_MAX; i++) {
-    Bullet &b = bullets[i];
-    if (b.life == 0) continue;
+  for (int i = 0; i < bulletProj.n; i++) {
+    int x1 = bulletProj.x1[i], y1 = bulletProj.y1[i];
+    int x2 = bulletProj.x2[i], y2 = bulletProj.y2[i];
 
-    float x1, y1, x2, y2;
-    project3(b.px, b.py, b.pz, cx, cy, x1, y1);
-    project3(b.x,  b.y,  b.z,  cx, cy, x2, y2);
+    if (!bandHit(oy, min(y1, y2) - 3, max(y1, y2) + 3)) continue;
 
-    // 画面内だけ
-    if (x2 < -10 || x2 > 330 || y2 < -10 || y2 > 230) continue;
+    y1 -= oy;
+    y2 -= oy;
 
     // 弾描画
-    if (b.type == WEAPON_GUN)
+    if (bulletProj.type[i] == WEAPON_GUN)
     {
-        M5.Display.drawLine((int)x1, (int)y1, (int)x2, (int)y2, ORANGE);
+        g.drawLine(x1, y1, x2, y2, ORANGE);
     }
     else
     {
     // ---- ミサイル本体（太め）----
     for (int w = -1; w <= 1; w++)
     {
-        M5.Display.drawLine(
-            (int)x1 + w,
-            (int)y1,
-            (int)x2 + w,
-            (int)y2,
+        g.drawLine(
+            x1 + w,
+            y1,
+            x2 + w,
+            y2,
             RED
         );
     }
@@ -1121,284 +1841,478 @@ void drawCockpit() {
 
           // ===== 青白グラデ =====
           uint8_t r = 180 - t * 15;
-          uint8_t g = 220 - t * 10;
-          uint8_t b = 255;
+          uint8_t g8 = 220 - t * 10;
+          uint8_t b8 = 255;
 
           if (r < 40) r = 40;
-          if (g < 80) g = 80;
+          if (g8 < 80) g8 = 80;
 
-          uint16_t plumeColor = M5.Display.color565(r, g, b);
+          uint16_t plumeColor = g.color565(r, g8, b8);
 
-          M5.Display.drawCircle((int)tx, (int)ty, spread, plumeColor);
+          g.drawCircle((int)tx, (int)ty, spread, plumeColor);
       }
     }
   }
 }
 // ---- Explosion draw (Ring + Sparks) ----
 {
-  float cx, cy;
-  getVanishingPoint(cx, cy);
+  uint16_t sparkColor = g.color565(255, 200, 80);
 
-  for (int i = 0; i < EXP_MAX; i++)
+  for (int i = 0; i < expProj.n; i++)
   {
-    if (explosions[i].life == 0) continue;
-
-    float sx, sy;
-    project3(explosions[i].x,
-             explosions[i].y,
-             explosions[i].z,
-             cx, cy, sx, sy);
-
-    int age = 20 - explosions[i].life;
+    int sy = expProj.sy[i];
+    int radius = expProj.radius[i];
+    if (!bandHit(oy, sy - radius - 40, sy + radius + 40)) continue;
 
     // 🔥 リング
-    int radius = age * 2.5;
-    uint8_t glow = 255 - age * 12;
-    uint16_t ringColor = M5.Display.color565(glow, glow/2, 0);
-
-    M5.Display.drawCircle((int)sx, (int)sy, radius, ringColor);
+    g.drawCircle(expProj.sx[i], sy - oy, radius, expProj.ringColor[i]);
 
     // ✨ 火花
-    for (int s = 0; s < 6; s++)
+    for (int s = 0; s < EXP_SPARKS; s++)
     {
-      float px = explosions[i].x + explosions[i].sparkVX[s] * age;
-      float py = explosions[i].y + explosions[i].sparkVY[s] * age;
-
-      float sx2, sy2;
-      project3(px, py, explosions[i].z,
-               cx, cy, sx2, sy2);
-
-      uint16_t sparkColor =
-        M5.Display.color565(255, 200, 80);
-
-      M5.Display.drawPixel((int)sx2, (int)sy2, sparkColor);
+      g.drawPixel(expProj.sparkX[s][i], expProj.sparkY[s][i] - oy, sparkColor);
     }
   }
 }
 
-
   // フラッシュ：半透明がないので “薄い矩形” で疑似
-  if ((int32_t)(millis() - fxFlashUntilMs) < 0) {
+  if (f.flash) {
     // コクピット中央だけ光らせる（画面全体より気持ちいい）
-    M5.Display.drawRect(14, 44, 292, 182, WHITE);
-    M5.Display.drawRect(15, 45, 290, 180, WHITE);
-  }
-  
-  float cx, cy;
-  getVanishingPoint(cx, cy);
-    if (lockActive && (int32_t)(millis() - lockUntilMs) >= 0)
-  {
-      lockActive = false;
+    g.drawRect(14, 44 - oy, 292, 182, WHITE);
+    g.drawRect(15, 45 - oy, 290, 180, WHITE);
   }
   
   if (lockActive)
-      drawLockOnReticle(cx, cy);
+      drawLockOnReticle(g, oy, f.cx, f.cy, f.lockBlink);
   else
-      drawReticle(cx, cy);
-
-  // ★ カメラと連動させる
-  float targetSpeed = 600 + camPitch * 120.0f;
-  float targetAlt   = 7800 + camYaw   * 500.0f;
-
-  // 慣性（0.05〜0.15くらいが良い）
-  hudSpeed += (targetSpeed - hudSpeed) * 0.08f;
-  hudAlt   += (targetAlt   - hudAlt)   * 0.08f;
+      drawReticle(g, oy, f.cx, f.cy);
 
-  int speed = constrain((int)hudSpeed, 200, 1200);
-  int alt   = constrain((int)hudAlt,   1000, 15000);
+  // ---- SPD / ALT ラベル ----
+  if (bandHit(oy, 72, 80)) {
+    g.setTextSize(1);
+    g.setTextColor(hudColor);
+    g.setCursor(28, 72 - oy);
+    g.print("[SPD]");
 
-  // ---- ワープ速度ターゲット ----
-  // 200〜1200 を 0.2〜1.8 にマッピング
-  warpSpeedTarget = 0.2f + (speed - 200) * (1.6f / 1000.0f);
-
-  // ---- SPD ラベル ----
-  M5.Display.setTextSize(1);
-  M5.Display.setTextColor(hudColor);
-  M5.Display.setCursor(28, 72);
-  M5.Display.print("[SPD]");
-
-  // ---- ALT ラベル ----
-  M5.Display.setCursor(260, 72);
-  M5.Display.print("[ALT]");
+    g.setCursor(260, 72 - oy);
+    g.print("[ALT]");
+  }
   
-  drawSpeedTape(speed);
-  drawAltTape(alt);
-  float heading = camYaw * 90.0f;
-  drawCompass(heading);
+  drawSpeedTape(g, oy, f.speed);
+  drawAltTape(g, oy, f.alt);
+  drawCompass(g, oy, f.heading);
 
-  if (warningActive)
+  if (warningActive && bandHit(oy, 185, 217))
   {
     int wx = 95;
-    int wy = 185;
+    int wy = 185 - oy;
     int ww = 130;
     int wh = 32;
 
     // 赤の透かし帯
-    uint16_t bg = M5.Display.color565(50, 0, 0);
-    M5.Display.fillRect(wx, wy, ww, wh, bg);
-
-    M5.Display.setTextSize(2);
-    M5.Display.setTextColor(hudColor);
-
-    if ((millis()/200)%2 == 0) {
-      M5.Display.setCursor(wx + 20, wy + 8);
-      M5.Display.print("WARNING");
+    uint16_t bg = g.color565(50, 0, 0);
+    g.fillRect(wx, wy, ww, wh, bg);
+    g.setTextSize(2);
+    g.setTextColor(hudColor);
+
+    if (f.warnBlink) {
+      g.setCursor(wx + 20, wy + 8);
+      g.print("WARNING");
     }
   }
 
   // ---- Weapon HUD ----
+  if (!bandHit(oy, 215, 223)) return;
+
   int wx = 145;
-  int wy = 215;
+  int wy = 215 - oy;
 
-  M5.Display.setTextSize(1);
-  M5.Display.setTextColor(hudColor);
-  uint16_t c = M5.Display.color565(255, 80, 0);
+  g.setTextSize(1);
+  g.setTextColor(hudColor);
+  uint16_t c = g.color565(255, 80, 0);
 
   // 枠なし・シンプル表示
   if (currentWeapon == WEAPON_GUN)
   {
-      M5.Display.setCursor(wx, wy);
-      M5.Display.print("[GUN]");
+      g.setCursor(wx, wy);
+      g.print("[GUN]");
   }
   else
   {
       // ミサイルは点滅
-      if ((millis()/150)%2==0)
+      if (f.mslBlink)
       {
-          M5.Display.setCursor(wx, wy);
-          M5.Display.setTextColor(c);
-          M5.Display.print("[MSL]");
+          g.setCursor(wx, wy);
+          g.setTextColor(c);
+          g.print("[MSL]");
       }
   }
 }
 
-void updateBullets(float dt) {
-  for (int i = 0; i < BULLET_MAX; i++) {
-    Bullet &b = bullets[i];
-    if (b.life == 0) continue;
+void updateCockpitPerf(uint32_t spiUs) {
+  cockpitSpiUs = spiUs;
 
-    b.px = b.x; b.py = b.y; b.pz = b.z;
+  uint32_t nowMs = millis();
+  if (cockpitFpsFrames++ == 0) cockpitFpsStartMs = nowMs;
+  uint32_t span = nowMs - cockpitFpsStartMs;
+  if (span >= 1000) {
+    cockpitFps = (cockpitFpsFrames - 1) * 1000.0f / span;
+    cockpitFpsFrames = 0;
+  }
+}
+
+void drawCockpit() {
+  updateCockpitFrame();
+
+  // スプライトが取れない時は従来どおり画面へ直接
+  if (!ensureCockpitBands()) {
+    cockpitBandH = 240;
+    uint32_t t0 = micros();
+    M5.Display.fillRect(0, 0, 320, 240, BLACK);
+    renderCockpit(M5.Display, 0);
+    updateCockpitPerf(micros() - t0);
+    return;
+  }
+
+  // 帯 k を描いている間に帯 k-1 が DMA で流れる。
+  // pushImageDMA は次の転送のウィンドウ設定で前の DMA の完了を待つので、
+  // 2本前に使ったバッファへ描き始める時点では転送は終わっている
+  cockpitBandH = COCKPIT_BAND_H;
+  uint32_t spiUs = 0;
+
+  M5.Display.startWrite();
+  for (int b = 0; b < COCKPIT_BANDS; b++) {
+    LGFX_Sprite& band = cockpitBand[b & 1];
+    int oy = b * COCKPIT_BAND_H;
+
+    band.fillSprite(BLACK);
+    renderCockpit(band, oy);
+
+    uint32_t t0 = micros();
+    M5.Display.pushImageDMA(0, oy, 320, COCKPIT_BAND_H,
+                            (const lgfx::swap565_t*)band.getBuffer());
+    spiUs += micros() - t0;
+  }
+  uint32_t t0 = micros();
+  M5.Display.waitDMA();
+  M5.Display.endWrite();
+  spiUs += micros() - t0;
 
-    b.age += dt;
+  updateCockpitPerf(spiUs);
+}
+
+void updateBullets(float dt) {
+  // 前回位置の保存と経過時間はまとめて
+  for (int k = 0; k < bulletPool.count; k++) {
+    int i = bulletPool.alive[k];
+    bullets.px[i] = bullets.x[i];
+    bullets.py[i] = bullets.y[i];
+    bullets.pz[i] = bullets.z[i];
+    bullets.age[i] += dt;
+  }
+
+  // 消すとき末尾と入れ替わるので後ろから回す
+  for (int k = bulletPool.count - 1; k >= 0; k--) {
+    int i = bulletPool.alive[k];
 
-    if (b.type == WEAPON_MISSILE)
+    if (bullets.type[i] == WEAPON_MISSILE)
     {
       // ---- 徐々に加速 ----
-      b.speed += dt * (1.8f + b.age * 4.0f);
-      if (b.speed > 4.5f) b.speed = 4.5f;
+      float speed = bullets.speed[i] + dt * (1.8f + bullets.age[i] * 4.0f);
+      if (speed > 4.5f) speed = 4.5f;
+      bullets.speed[i] = speed;
 
       // ---- 0.18秒後に前へ収束 ----
-      if (b.age > 0.10f)
+      if (bullets.age[i] > 0.10f)
       {
-        float pull = -b.x * 3.0f;
-        b.vx += pull * dt;
-        b.vx *= 0.90f;
+        float pull = -bullets.x[i] * 3.0f;
+        bullets.vx[i] += pull * dt;
+        bullets.vx[i] *= MISSILE_DAMP;
       }
 
-      b.x += b.vx * b.speed * dt;
-      b.y += b.vy * b.speed * dt;
-      b.z += b.vz * b.speed * dt;
+      bullets.x[i] += bullets.vx[i] * speed * dt;
+      bullets.y[i] += bullets.vy[i] * speed * dt;
+      bullets.z[i] += bullets.vz[i] * speed * dt;
     }
     else
     {
-      b.z += b.vz * dt;
+      bullets.z[i] += bullets.vz[i] * dt;
     }   // ★奥へ進む
-    b.life--;
 
     // 奥へ行き過ぎ or 寿命
-    if (b.z > 1.20f)
+    if (--bullets.life[i] == 0 || bullets.z[i] > 1.20f)
     {
-      // ★ ミサイルのみ爆発
-      if (b.type == WEAPON_MISSILE)
+      if (bullets.type[i] == WEAPON_MISSILE)
       {
-        spawnExplosion(b.x, b.y, b.z);
+        // ★ ミサイルのみ爆発
+        if (bullets.z[i] > 1.20f)
+          spawnExplosion(bullets.x[i], bullets.y[i], bullets.z[i]);
+        missileAlive--;
       }
-
-      b.life = 0;
+      bulletPool.release(i);
     }
   }
 
-  for (int i = 0; i < EXP_MAX; i++)
+  for (int k = expPool.count - 1; k >= 0; k--)
   {
-    if (explosions[i].life > 0)
+    int i = expPool.alive[k];
+    if (--explosions.life[i] == 0)
     {
-      explosions[i].life--;
-
-      // 火花を広げる
-      for (int s = 0; s < 6; s++)
-      {
-        explosions[i].sparkVX[s] *= 1.05f;
-        explosions[i].sparkVY[s] *= 1.05f;
-      }
+      expPool.release(i);
     }
   }
-  bool missileAlive = false;
-  bool explosionAlive = false;
 
-    for (int i = 0; i < BULLET_MAX; i++)
+  // 火花を広げる
+  for (int s = 0; s < EXP_SPARKS; s++)
+  {
+    for (int k = 0; k < expPool.count; k++)
     {
-        if (bullets[i].life > 0 &&
-            bullets[i].type == WEAPON_MISSILE)
-            missileAlive = true;
+      int i = expPool.alive[k];
+      explosions.sparkVX[s][i] *= SPARK_GROW;
+      explosions.sparkVY[s][i] *= SPARK_GROW;
     }
+  }
 
-    for (int i = 0; i < EXP_MAX; i++)
-    {
-        if (explosions[i].life > 0)
-            explosionAlive = true;
-    }
+  if (missileAlive == 0 && expPool.count == 0)
+  {
+      currentWeapon = WEAPON_GUN;
+  }
+}
 
-    if (!missileAlive && !explosionAlive)
-    {
-        currentWeapon = WEAPON_GUN;
-    }
+// ==== コクピット物理（固定ステップ）====
+void stepCockpit(float dt) {
+  prevCamYaw   = camYaw;
+  prevCamPitch = camPitch;
+
+  // ---- ワープ速度制御 ----
+  static const float accelRate = simRate(0.14f);
+  static const float decelRate = simRate(0.035f);
+
+  float diff = warpSpeedTarget - warpSpeed;
+
+  if (diff > 0.0f) warpSpeed += diff * accelRate;
+  else             warpSpeed += diff * decelRate;
+
+  float speed01 = constrain((warpSpeed - 0.2f) / 1.6f, 0.0f, 1.0f);
+  warpSpeed += speed01 * 0.015f / SIM_TICKS_60;
+
+  if (warpSpeed > 1.4f) camPitchVel += 0.02f / SIM_TICKS_60;
+
+  updateCamera(dt);
+  updateStars(dt);
+  updateBullets(dt);
+
+  // ★ カメラと連動させる
+  float targetSpeed = 600 + camPitch * 120.0f;
+  float targetAlt   = 7800 + camYaw   * 500.0f;
+
+  // 慣性（0.05〜0.15くらいが良い）
+  static const float hudRate = simRate(0.08f);
+  hudSpeed += (targetSpeed - hudSpeed) * hudRate;
+  hudAlt   += (targetAlt   - hudAlt)   * hudRate;
+
+  // ---- ワープ速度ターゲット ----
+  // 200〜1200 を 0.2〜1.8 にマッピング
+  int speed = constrain((int)hudSpeed, 200, 1200);
+  warpSpeedTarget = 0.2f + (speed - 200) * (1.6f / 1000.0f);
 }
 
+// 経過時間ぶんだけ固定ステップを回し、余りを補間係数にする
+void advanceCockpit() {
+  uint32_t now = nowUs();
+  simAccumUs += now - simLastUs;
+  simLastUs = now;
+
+  // 描画が大きく止まったときは追いつかせず捨てる（ワープ防止）
+  if (simAccumUs > (uint32_t)(SIM_STEP_US * SIM_MAX_STEPS)) {
+    simAccumUs = SIM_STEP_US * SIM_MAX_STEPS;
+  }
+
+  while (simAccumUs >= (uint32_t)SIM_STEP_US) {
+    stepCockpit(SIM_DT);
+    simAccumUs -= SIM_STEP_US;
+  }
+  simAlpha = (float)simAccumUs / SIM_STEP_US;
+}
 
 // ======================================================
 // I2C受信 ISR
 // I2C モードのときのみ登録する
 // ======================================================
 volatile bool solenoidRequest = false;
-volatile uint32_t solenoidRequestTime = 0;
-// I2C受信 → 依頼だけ積む（ISR/コールバック内は軽く）
-volatile uint8_t solenoidReqCount = 0;
 
-// ---- I2C trigger gate ----
-volatile bool     solenoidPending = false;
+// ---- 発火イベント（Wire コールバック → スケジューラ → 予定時刻タイマー → loop） ----
+// コールバックは種類と受信時刻を積むだけ。共有状態には触らない。
+// スケジューラタスクが間隔を決めて 2段クリックを両方予約し、予定時刻のタイマーがピストンを起動する。
+// バイブの立ち上がりも同じタイマーで起動する。loop は画面・武装状態を適用するだけ
+// （描画負荷で 2段の間隔やバイブの開始時刻が崩れない）
+enum FireType : uint8_t {
+    FIRE_LIGHT = 0,
+    FIRE_STRONG,
+    FIRE_ENTER,
+};
+
+struct FireEvent {
+    uint8_t  type;
+    uint32_t rxUs;    // 受信時刻
+    uint32_t dueUs;   // 発火予定（スケジューラが決める）
+};
+
+// 1対1 のリングバッファ（head は書き手だけ、tail は読み手だけが進める）
+const uint8_t FIRE_RING_SIZE = 16;
+
+struct FireRing {
+    FireEvent buf[FIRE_RING_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    volatile uint32_t dropped;
+};
+
+static FireRing i2cFireRing = {};   // Wire コールバック → スケジューラ
+static FireRing fireDueRing = {};   // スケジューラ → 予定時刻タイマー
+static FireRing fireFxRing  = {};   // 予定時刻タイマー → loop
+
+inline bool fireRingPush(FireRing& r, const FireEvent& e) {
+    uint8_t next = (r.head + 1) % FIRE_RING_SIZE;
+    if (next == r.tail) {
+        r.dropped++;
+        return false;
+    }
+    r.buf[r.head] = e;
+    __sync_synchronize();
+    r.head = next;
+    return true;
+}
+
+inline bool fireRingPeek(FireRing& r, FireEvent& e) {
+    if (r.tail == r.head) return false;
+    __sync_synchronize();
+    e = r.buf[r.tail];
+    return true;
+}
+
+inline void fireRingPop(FireRing& r) {
+    r.tail = (r.tail + 1) % FIRE_RING_SIZE;
+}
+
+const uint32_t I2C_MIN_INTERVAL_US = 8000;  // ← 調整可（連打の最短間隔）
 
-volatile uint32_t lastI2CFireMs = 0;
-const uint32_t I2C_MIN_INTERVAL_MS = 8;  // ← 調整可
-volatile uint8_t i2cFireCount = 0;
+static TaskHandle_t fireSchedTask = nullptr;
+static esp_timer_handle_t fireDueTimer = nullptr;
 
 void onReceiveEvent(int numBytes) {
     if (numBytes <= 0) return;
 
+    FireEvent e = { 0, nowUs(), 0 };
     uint8_t cmd = Wire.read();
     while (Wire.available()) Wire.read();
 
-    // ---- Enterだけミサイル ----
-    if (cmd == SOL_CMD_ENT) {
-        currentWeapon = WEAPON_MISSILE;
-        lockActive = true;
-        lockUntilMs = millis() + 1200;
+    if      (cmd == SOL_CMD_ENT)    e.type = FIRE_ENTER;
+    else if (cmd == SOL_CMD_STRONG) e.type = FIRE_STRONG;
+    else if (cmd == SOL_CMD_LIGHT)  e.type = FIRE_LIGHT;
+    else return;
 
-        onFireVisualFX(true);
-        solenoidEffect();
+    if (fireRingPush(i2cFireRing, e) && fireSchedTask) {
+        xTaskNotifyGive(fireSchedTask);
+    }
+}
 
-        return;
+inline ClickKind fireClickKind(uint8_t type) {
+    switch (type) {
+        case FIRE_ENTER:  return CLICK_MISSILE;
+        case FIRE_STRONG: return CLICK_STRONG;
+        default:          return CLICK_LIGHT;
     }
+}
 
-    // ---- それ以外は常に通常弾 ----
-    currentWeapon = WEAPON_GUN;
+// 先頭の予定時刻でタイマーをアームする。既にアーム済みならそちらが先（リングは時刻順）
+inline void armFireDueTimer(uint32_t dueUs) {
+    int32_t wait = (int32_t)(dueUs - nowUs());
+    esp_timer_start_once(fireDueTimer, wait > 0 ? wait : 0);
+}
 
-    if (cmd == SOL_CMD_LIGHT || cmd == SOL_CMD_STRONG) {
-        if (i2cFireCount < 10) {
-            i2cFireCount++;
+// 予定時刻タイマー（esp_timer タスク）：来たものからバイブとピストンを起動して loop へ回す
+void fireDueTimerCb(void* arg) {
+    FireEvent e;
+    while (fireRingPeek(fireDueRing, e)) {
+        if ((int32_t)(nowUs() - e.dueUs) < 0) {
+            armFireDueTimer(e.dueUs);
+            return;
         }
+        fireRingPop(fireDueRing);
+
+        ClickKind kind = fireClickKind(e.type);
+        hapticPlay(kind, e.rxUs);
+        postSolenoidRequest(SOL_REQ_NORMAL, kind);
+        fireRingPush(fireFxRing, e);
     }
 }
 
+// 受信順に発火時刻を決め、2段クリックの音をその時刻基準で両方予約する。
+// ミサイルは間隔制限なし。ただしリングを時刻順に保つため直前の予定よりは前にしない
+void fireSchedulerTask(void* arg) {
+    uint32_t lastDueUs = 0;
+    uint32_t lastAnyDueUs = 0;
+    FireEvent e;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (fireRingPeek(i2cFireRing, e)) {
+            e.dueUs = e.rxUs;
+            if (e.type != FIRE_ENTER &&
+                (int32_t)(lastDueUs + I2C_MIN_INTERVAL_US - e.dueUs) > 0) {
+                e.dueUs = lastDueUs + I2C_MIN_INTERVAL_US;
+            }
+            if ((int32_t)(lastAnyDueUs - e.dueUs) > 0) e.dueUs = lastAnyDueUs;
+            if (e.type != FIRE_ENTER) lastDueUs = e.dueUs;
+            lastAnyDueUs = e.dueUs;
+
+            fireRingPop(i2cFireRing);
+            if (!fireRingPush(fireDueRing, e)) continue;   // 溢れたら音も鳴らさない
+
+            ClickKind kind = fireClickKind(e.type);
+            playClick(kind, e.rxUs, e.dueUs);
+            playClick(kind, 0, e.dueUs + SOL_NORMAL_STEP_US * SOL_NORMAL_STEPS);
+            armFireDueTimer(e.dueUs);
+        }
+    }
+}
+
+// loop 側：予定時刻を過ぎたものから演出・武装状態を反映
+void dispatchI2CFires() {
+    FireEvent e;
+    while (fireRingPeek(fireFxRing, e)) {
+        fireRingPop(fireFxRing);
+
+        if (e.type == FIRE_ENTER) {
+            currentWeapon = WEAPON_MISSILE;
+            lockActive = true;
+            lockUntilMs = millis() + 1200;
+            onFireVisualFX(true);
+        } else {
+            currentWeapon = WEAPON_GUN;
+            fireSolenoidByTiming(fireClickKind(e.type), e.rxUs, true);
+        }
+    }
+}
+
+void printLatency(Stream& out) {
+    latPrint(out, "audio", latAudio);
+    latPrint(out, "haptic", latHaptic);
+    out.printf("[HAP] edges=%lu err avg=%luus max=%luus last=%ldus retrig=%lu lost=%lu\n",
+               (unsigned long)vibPulseStats.count,
+               (unsigned long)(vibPulseStats.count ? vibPulseStats.sumErrUs / vibPulseStats.count : 0),
+               (unsigned long)vibPulseStats.maxErrUs,
+               (long)vibPulseStats.lastErrUs,
+               (unsigned long)vibPulseStats.retriggers,
+               (unsigned long)vibPulseStats.lostSteps);
+    out.printf("[LAT] fire drop i2c=%lu due=%lu fx=%lu\n",
+               (unsigned long)i2cFireRing.dropped,
+               (unsigned long)fireDueRing.dropped,
+               (unsigned long)fireFxRing.dropped);
+}
+
 
 // ======================================================
 // 設定UI
@@ -1439,6 +2353,24 @@ void drawConfigUI() {
       15, ORANGE);
 
 
+  // バイブ波形の段切り替え時刻の誤差（実測 − 予定）
+  M5.Display.setTextSize(1);
+  M5.Display.setTextColor(DARKGREY);
+  M5.Display.setCursor(200, 24);
+  M5.Display.printf("PULSE err %ld/%luus",
+                    (long)vibPulseStats.lastErrUs,
+                    (unsigned long)vibPulseStats.maxErrUs);
+
+  // ミキサー統計（ボイス奪い合い・飽和）
+  M5.Display.setTextSize(1);
+  M5.Display.setTextColor(DARKGREY);
+  M5.Display.setCursor(20, 228);
+  M5.Display.printf("MIX v%d/%d  clicks:%lu  stolen:%lu  clip:%lu",
+                    mixStats.peakVoices, MIX_VOICES,
+                    (unsigned long)mixStats.started,
+                    (unsigned long)mixStats.stolen,
+                    (unsigned long)mixStats.clipped);
+
   // 上に通信インジケータも表示
   drawCommIndicator();
 }
@@ -1514,7 +2446,7 @@ void handleConfigTouch() {
     if (t.y > 80 + offsetY && t.y < 115 + offsetY) {
       vibStrength = constrain(map(t.x, 20, 240, 0, 255), 0, 255);
       drawConfigUI();
-      pulseVibrationFast();
+      hapticPlay(CLICK_LIGHT);
     }
     // Tone slider（3500〜7000Hz）
     else if (t.y > 150 + offsetY && t.y < 185 + offsetY) {
@@ -1589,7 +2521,7 @@ void checkTouchToConfig() {
 // ======================================================
 static bool sol_wait_header = false;
 
-void handleSerialByte(uint8_t b, CommSource src) {
+void handleSerialByte(uint8_t b, CommSource src, uint32_t rxUs) {
   activeSource = src;
 
   // ===== Solenoid 2-byte frame =====
@@ -1603,10 +2535,16 @@ void handleSerialByte(uint8_t b, CommSource src) {
   // header を受けた次の1byteだけ評価
   sol_wait_header = false;
 
+  if (b == SOL_CMD_LATENCY) {
+    if (src == SRC_BT) printLatency(SerialBT);
+    else               printLatency(Serial);
+    return;
+  }
+
   if (b == SOL_CMD_LIGHT || b == SOL_CMD_STRONG) {
     currentWeapon = WEAPON_GUN;
     lockActive = false;
-    fireSolenoidByTiming();
+    fireSolenoidByTiming(b == SOL_CMD_STRONG ? CLICK_STRONG : CLICK_LIGHT, rxUs);
     usb_state = 0;   // 他のステートを壊してOK
     return;
   }
@@ -1617,7 +2555,7 @@ void handleSerialByte(uint8_t b, CommSource src) {
           lockUntilMs = millis() + 1200;   // ★1.2秒ロック維持
           currentWeapon = WEAPON_MISSILE;
           onFireVisualFX(true);
-          solenoidEffect();
+          solenoidEffect(CLICK_MISSILE, rxUs);
       }
       return;
   }
@@ -1658,15 +2596,25 @@ void handleSerialByte(uint8_t b, CommSource src) {
 // ======================================================
 void pollSerialInputs() {
   // USB シリアル優先で全て読む
+  // 受信時刻はまとめて読んだ時点で刻む（バイト単位より粗いが loop 周期よりは細かい）
+  uint32_t rxUs = nowUs();
   while (Serial.available() > 0) {
     uint8_t b = Serial.read();
-    handleSerialByte(b, SRC_USB);
+    handleSerialByte(b, SRC_USB, rxUs);
   }
 
   // BT シリアル側も同様に読む
+  rxUs = nowUs();
   while (SerialBT.available() > 0) {
     uint8_t b = SerialBT.read();
-    handleSerialByte(b, SRC_BT);
+    handleSerialByte(b, SRC_BT, rxUs);
+  }
+}
+
+// I2C / DEMO モードでは USB シリアルは遅延ヒストグラムの読み出し専用
+void pollLatencyRequest() {
+  while (Serial.available() > 0) {
+    if (Serial.read() == SOL_CMD_LATENCY) printLatency(Serial);
   }
 }
 
@@ -1876,7 +2824,9 @@ void setup() {
 
   applyInvertMode();
 
-  audioQueue = xQueueCreate(8, sizeof(uint8_t));
+  audioQueue = xQueueCreate(8, sizeof(AudioEvt));
+  initHaptics();
+  initSolenoidTimer();
 
    xTaskCreatePinnedToCore(
      audioTask,
@@ -1898,11 +2848,26 @@ void setup() {
     activeSource = SRC_NONE;        // 最初は未接続
   } else if (appMode == MODE_I2C) {
     // I2Cのみ有効（USB/BTは開始しない）
+    esp_timer_create_args_t dueArgs = {};
+    dueArgs.callback = fireDueTimerCb;
+    dueArgs.name     = "fireDue";
+    esp_timer_create(&dueArgs, &fireDueTimer);
+    xTaskCreatePinnedToCore(
+      fireSchedulerTask,
+      "fireSched",
+      3072,
+      NULL,
+      4,      // 音タスクより上（積むだけなので軽い）
+      &fireSchedTask,
+      1
+    );
     Wire.begin(I2C_ADDRESS, 32, 33, 400000);
     Wire.onReceive(onReceiveEvent);
+    Serial.begin(115200);           // 遅延ヒストグラム読み出し用
     activeSource = SRC_I2C;         // インジケータは黄色に近い状態
   } else { // MODE_DEMO
     // 通信なし（Demoモード）
+    Serial.begin(115200);           // 遅延ヒストグラム読み出し用
     activeSource = SRC_NONE;
   }
 
@@ -1916,9 +2881,6 @@ void setup() {
 // ======================================================
 // メインループ
 // ======================================================
-static uint32_t lastI2CProcessMs = 0;
-const uint32_t I2C_PROCESS_INTERVAL_MS = 8;
-
 void loop() {
   M5.update();
 
@@ -1927,12 +2889,10 @@ void loop() {
   updateBatteryUI();
   if (batteryDirty) { drawBatteryIndicator(); batteryDirty = false; }
 
- if (uiTheme != THEME_COCKPIT) {
-    updateSolenoid();
-  }
-  updateVibrationPulse();
+  updateSolenoid();
 
   if (solenoidRequest) { solenoidRequest = false; fireSolenoidByTiming(); }
+  if (appMode == MODE_I2C) dispatchI2CFires();
 
   // ==== Frame limiter (60fps) ====
 const uint32_t FRAME_MS = 16;  // 1000/60 ≒ 16ms
@@ -1951,15 +2911,6 @@ if (warningActive)
   }
 }
 
-if (i2cFireCount > 0) {
-    uint32_t now = millis();
-    if (now - lastI2CProcessMs >= I2C_PROCESS_INTERVAL_MS) {
-        i2cFireCount--;
-        lastI2CProcessMs = now;
-        fireSolenoidByTiming();
-    }
-}
-
 
 // HUD色切替
 hudColor = warningActive ? HUD_WARNING : HUD_NORMAL;
@@ -1980,31 +2931,12 @@ hudColor = warningActive ? HUD_WARNING : HUD_NORMAL;
       return;
   }
 
-  float dt = (nowMs - lastDrawMs) / 1000.0f;
-  if (dt > 0.05f) dt = 0.05f;
-
   lastDrawMs = nowMs;
 
-      // ---- ワープ速度制御 ----
-      float diff = warpSpeedTarget - warpSpeed;
-
-      const float accelRate = 0.14f;
-      const float decelRate = 0.035f;
-
-      if (diff > 0.0f) warpSpeed += diff * accelRate;
-      else             warpSpeed += diff * decelRate;
-
-      float speed01 = constrain((warpSpeed - 0.2f) / 1.6f, 0.0f, 1.0f);
-      warpSpeed += speed01 * 0.015f;
-
-      if (warpSpeed > 1.4f) camPitchVel += 0.02f;
-
-
+      // 物理は固定ステップ、描画はその補間（FRAME_MS は描画側の上限だけ）
       ensureHudSprite();
       consumeFXEvents();
-      updateCamera(dt);
-      updateStars(dt);
-      updateBullets(dt);
+      advanceCockpit();
       drawCockpit();
   }
 
@@ -2013,6 +2945,7 @@ hudColor = warningActive ? HUD_WARNING : HUD_NORMAL;
   if (prevSource != activeSource) { prevSource = activeSource; drawCommIndicator(); }
 
   if (appMode == MODE_USB_BT) pollSerialInputs();
+  else                       pollLatencyRequest();
 
 if (configMode)
 {
@@ -2101,7 +3034,7 @@ if (configMode)
           // 発射エフェクト
           spawnBarrage(2);     // 直接出す
           // 自動でGUNに戻す
-          solenoidEffect(); 
+          solenoidEffect(CLICK_MISSILE); 
       }
       else
       {
@@ -2127,9 +3060,9 @@ if (configMode)
     } else {
       // 短押しは “強打” の気分
       onFireVisualFX(true);
-      solenoidEffect();
+      solenoidEffect(CLICK_STRONG);
       lastFireMs = millis();
-      startFastSolenoid();
+      startFastSolenoid(CLICK_STRONG);
     }
   }
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+// ParticlePool の正しさと、数百粒子での alloc / release / 定常更新の速さ
+// pio test -e native -v で実行（ベンチ結果は printf で出る）
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+#include "ParticlePool.h"
+
+static const int POOL_N = 512;
+static ParticlePool<POOL_N> pool;
+
+void setUp() { pool.init(); }
+void tearDown() {}
+
+// alive / aliveAt / freeList が互いに矛盾していないか
+static void checkConsistent() {
+  TEST_ASSERT_EQUAL_INT(POOL_N, pool.count + pool.freeTop);
+  static bool used[POOL_N];
+  for (int i = 0; i < POOL_N; i++) used[i] = false;
+  for (int k = 0; k < pool.count; k++) {
+    uint16_t s = pool.alive[k];
+    TEST_ASSERT_TRUE(s < POOL_N);
+    TEST_ASSERT_FALSE(used[s]);
+    TEST_ASSERT_EQUAL_INT(k, pool.aliveAt[s]);
+    used[s] = true;
+  }
+  for (int k = 0; k < pool.freeTop; k++) {
+    uint16_t s = pool.freeList[k];
+    TEST_ASSERT_TRUE(s < POOL_N);
+    TEST_ASSERT_FALSE(used[s]);
+    used[s] = true;
+  }
+}
+
+void test_alloc_until_full() {
+  for (int i = 0; i < POOL_N; i++) {
+    TEST_ASSERT_TRUE(pool.alloc() >= 0);
+  }
+  TEST_ASSERT_EQUAL_INT(-1, pool.alloc());
+  TEST_ASSERT_EQUAL_INT(POOL_N, pool.count);
+  checkConsistent();
+}
+
+void test_release_keeps_alive_dense() {
+  for (int i = 0; i < 8; i++) pool.alloc();
+  pool.release(pool.alive[3]);
+  pool.release(pool.alive[0]);
+  TEST_ASSERT_EQUAL_INT(6, pool.count);
+  checkConsistent();
+
+  // 解放したスロットは次の alloc で再利用される
+  int s = pool.alloc();
+  TEST_ASSERT_TRUE(s >= 0);
+  TEST_ASSERT_EQUAL_INT(7, pool.count);
+  checkConsistent();
+}
+
+void test_release_while_iterating_backwards() {
+  for (int i = 0; i < 300; i++) pool.alloc();
+  // 走査しながら消すときは末尾から（main.cpp の updateBullets と同じ回し方）
+  for (int k = pool.count - 1; k >= 0; k--) {
+    uint16_t s = pool.alive[k];
+    if (s % 3 == 0) pool.release(s);
+  }
+  checkConsistent();
+  for (int k = 0; k < pool.count; k++) {
+    TEST_ASSERT_NOT_EQUAL(0, pool.alive[k] % 3);
+  }
+}
+
+// ---- ベンチマーク ----
+// 弾と同じ SoA 形で、毎ステップ寿命切れを消して新しい粒子を足す
+static struct {
+  float x[POOL_N], y[POOL_N], z[POOL_N];
+  float vx[POOL_N], vy[POOL_N], vz[POOL_N];
+  uint16_t life[POOL_N];
+} soa;
+
+static uint32_t rng = 12345;
+static inline uint32_t nextRand() {
+  rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+  return rng;
+}
+
+static void spawn() {
+  int s = pool.alloc();
+  if (s < 0) return;
+  soa.x[s] = soa.y[s] = 0.0f;
+  soa.z[s] = 0.1f;
+  soa.vx[s] = (int)(nextRand() % 200 - 100) * 0.0001f;
+  soa.vy[s] = (int)(nextRand() % 200 - 100) * 0.0001f;
+  soa.vz[s] = 0.02f;
+  soa.life[s] = 60 + nextRand() % 120;
+}
+
+static void step() {
+  for (int k = pool.count - 1; k >= 0; k--) {
+    uint16_t s = pool.alive[k];
+    soa.x[s] += soa.vx[s];
+    soa.y[s] += soa.vy[s];
+    soa.z[s] += soa.vz[s];
+    if (--soa.life[s] == 0) pool.release(s);
+  }
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void test_bench_alloc_release() {
+  const int ROUNDS = 20000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < POOL_N; i++) pool.alloc();
+    for (int k = pool.count - 1; k >= 0; k--) pool.release(pool.alive[k]);
+  }
+  double sec = secondsSince(t0);
+  checkConsistent();
+  double ops = 2.0 * ROUNDS * POOL_N;
+  printf("[BENCH] pool alloc+release: %.1f Mops/s (%.2f ns/op)\n",
+         ops / sec / 1e6, sec / ops * 1e9);
+}
+
+void test_bench_steady_state_update() {
+  // 1ステップ 4粒子ずつ足して 400 前後で落ち着かせる
+  for (int i = 0; i < 2000; i++) {
+    for (int j = 0; j < 4; j++) spawn();
+    step();
+  }
+  TEST_ASSERT_TRUE(pool.count >= 300);
+
+  const int STEPS = 200000;
+  uint64_t updated = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < STEPS; i++) {
+    for (int j = 0; j < 4; j++) spawn();
+    updated += pool.count;
+    step();
+  }
+  double sec = secondsSince(t0);
+  checkConsistent();
+  printf("[BENCH] steady state: %u alive, %.1f M particle-steps/s, %.2f us/step\n",
+         (unsigned)pool.count, updated / sec / 1e6, sec / STEPS * 1e6);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_alloc_until_full);
+  RUN_TEST(test_release_keeps_alive_dense);
+  RUN_TEST(test_release_while_iterating_backwards);
+  RUN_TEST(test_bench_alloc_release);
+  RUN_TEST(test_bench_steady_state_update);
+  return UNITY_END();
+}
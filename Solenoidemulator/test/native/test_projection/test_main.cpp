@@ -0,0 +1,127 @@
+// Q16 投影カーネル（recipZ / projectQ16）の精度と、投影点数/秒のベンチマーク
+// pio test -e native -v で実行（ベンチ結果は printf で出る）
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <chrono>
+
+#include "ProjectionQ16.h"
+
+void setUp() {}
+void tearDown() {}
+
+// z = 0.04..2 の全 Q16 値で fov / z と比べる（表の補間誤差 < 0.1%）
+void test_recip_z_accuracy() {
+  double worst = 0.0;
+  int32_t worstZq = 0;
+  for (int32_t zq = RZ_MIN_Q; zq < RZ_MAX_Q; zq++) {
+    double ref = PROJ_FOV / (zq / 65536.0);
+    double got = recipZ(zq) / 65536.0;
+    double err = fabs(got - ref) / ref;
+    if (err > worst) {
+      worst = err;
+      worstZq = zq;
+    }
+  }
+  printf("[ACC] recipZ max rel err %.4f%% at z=%.5f\n", worst * 100.0, worstZq / 65536.0);
+  TEST_ASSERT_LESS_THAN_FLOAT(0.001f, (float)worst);
+}
+
+// 範囲外は端で打ち切る
+void test_recip_z_clamps() {
+  TEST_ASSERT_EQUAL_INT(recipZ(RZ_MIN_Q), recipZ(0));
+  TEST_ASSERT_EQUAL_INT(recipZ(RZ_MIN_Q), recipZ(-65536));
+  TEST_ASSERT_EQUAL_INT(recipZ(RZ_MAX_Q - 1), recipZ(RZ_MAX_Q));
+  TEST_ASSERT_EQUAL_INT(recipZ(RZ_MAX_Q - 1), recipZ(10 << 16));
+}
+
+// 画面に入る点は float の透視投影と 1px 未満で一致する
+void test_project_matches_float() {
+  const float cx = 160.0f, cy = 140.0f;
+  float worst = 0.0f;
+  for (int i = 0; i < 2000; i++) {
+    float x = -1.0f + 2.0f * (i % 41) / 40.0f;
+    float y = -1.0f + 2.0f * (i % 37) / 36.0f;
+    float z = 0.04f + 1.95f * (i % 97) / 96.0f;
+
+    int32_t sxq, syq;
+    projectQ16(toQ16(x), toQ16(y), recipZ(toQ16(z)), toQ16(cx), toQ16(cy), sxq, syq);
+
+    float inv = PROJ_FOV / z;
+    float fx = cx + x * inv * 160.0f;
+    float fy = cy + y * inv * 120.0f;
+    if (fx < 0.0f || fx >= 320.0f || fy < 0.0f || fy >= 240.0f) continue;
+
+    float ex = fabsf(sxq / 65536.0f - fx);
+    float ey = fabsf(syq / 65536.0f - fy);
+    if (ex > worst) worst = ex;
+    if (ey > worst) worst = ey;
+  }
+  printf("[ACC] projectQ16 max screen err %.3f px\n", worst);
+  TEST_ASSERT_LESS_THAN_FLOAT(1.0f, worst);
+}
+
+// ---- ベンチマーク ----
+static const int PTS = 4096;
+static int32_t xs[PTS], ys[PTS], zs[PTS];
+static float   xf[PTS], yf[PTS], zf[PTS];
+
+static double secondsSince(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void test_bench_points_per_second() {
+  uint32_t rng = 2463534242u;
+  for (int i = 0; i < PTS; i++) {
+    rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+    xf[i] = (int)(rng % 2001 - 1000) / 1000.0f;
+    yf[i] = (int)((rng >> 11) % 2001 - 1000) / 1000.0f;
+    zf[i] = 0.04f + (rng >> 21) % 1000 / 1000.0f * 1.96f;
+    xs[i] = toQ16(xf[i]);
+    ys[i] = toQ16(yf[i]);
+    zs[i] = toQ16(zf[i]);
+  }
+
+  const int ROUNDS = 5000;
+  const int32_t cxq = toQ16(160.0f), cyq = toQ16(140.0f);
+
+  int64_t sumQ = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < PTS; i++) {
+      int32_t sx, sy;
+      projectQ16(xs[i], ys[i], recipZ(zs[i]), cxq, cyq, sx, sy);
+      sumQ += sx ^ sy;
+    }
+  }
+  double secQ = secondsSince(t0);
+
+  // 比較用：置き換え前と同じ float の割り算版
+  double sumF = 0;
+  t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < PTS; i++) {
+      float inv = PROJ_FOV / zf[i];
+      sumF += (160.0f + xf[i] * inv * 160.0f) + (140.0f + yf[i] * inv * 120.0f);
+    }
+  }
+  double secF = secondsSince(t0);
+
+  double pts = (double)ROUNDS * PTS;
+  printf("[BENCH] Q16 projection:   %.1f M points/s (checksum %lld)\n",
+         pts / secQ / 1e6, (long long)sumQ);
+  printf("[BENCH] float projection: %.1f M points/s (checksum %.0f)\n",
+         pts / secF / 1e6, sumF);
+  TEST_ASSERT_TRUE(secQ > 0.0);
+}
+
+int main() {
+  initRecipZTable();
+  UNITY_BEGIN();
+  RUN_TEST(test_recip_z_accuracy);
+  RUN_TEST(test_recip_z_clamps);
+  RUN_TEST(test_project_matches_float);
+  RUN_TEST(test_bench_points_per_second);
+  return UNITY_END();
+}
@@ -1,6 +1,5 @@
 #include <Arduino.h>
 #include <M5Unified.h>
-#include <vector>
 #include <algorithm>
 #include <math.h>
 #include <BluetoothSerial.h>
@@ -8,9 +7,34 @@
 // =============================
 // 設定
 // =============================
-const int GRID_SIZE = 8;
 const float SPHERE_RADIUS = 100.0f;
 
+// ===== LOD（0が最精細） =====
+const int LOD_COUNT = 4;
+constexpr int LOD_GRID[LOD_COUNT] = {12, 8, 6, 4};
+const int MAX_GRID = 12;
+
+// 共有頂点のキューブ球: 頂点 6G^2+2 / 面 6G^2
+constexpr int lodVertexCount(int g) { return 6*g*g + 2; }
+constexpr int lodQuadCount(int g)   { return 6*g*g; }
+
+const int MAX_LOD_VERTS = lodVertexCount(MAX_GRID);
+const int MAX_LOD_QUADS = lodQuadCount(MAX_GRID);
+
+// 全LOD分の合計（LOD_GRID から求めるので表を変えてもバッファがずれない）
+constexpr int lodVertexTotal(int l = 0) {
+  return l >= LOD_COUNT ? 0 : lodVertexCount(LOD_GRID[l]) + lodVertexTotal(l + 1);
+}
+constexpr int lodQuadTotal(int l = 0) {
+  return l >= LOD_COUNT ? 0 : lodQuadCount(LOD_GRID[l]) + lodQuadTotal(l + 1);
+}
+
+const int TOTAL_VERTS = lodVertexTotal();
+const int TOTAL_QUADS = lodQuadTotal();
+
+// 描画1回分の予算（push前のラスタライズ時間）
+const uint32_t LOD_RENDER_BUDGET_US = 8000;
+
 const int CANVAS_WIDTH = 200;
 const int CANVAS_HEIGHT = 200;
 
@@ -21,9 +45,6 @@ float sensGain = 0.005f;   // 感度（まずここ上げる）
 float SMOOTH = 0.0f;   // 入力の滑らかさ
 float FRICTION = 0.75f; // 慣性
 
-float accDX = 0;
-float accDY = 0;
-
 bool movementStarted = false;
 
 BluetoothSerial SerialBT;
@@ -56,6 +77,43 @@ float clickFx = 0.0f;
 
 float tapTravel = 0.0f;
 
+// =============================
+// 入力タスク（固定周期サンプリング）
+// =============================
+// タッチ取得とマウスデルタ送信は描画から切り離し、
+// 専用タスクで固定周期に回す
+const uint32_t INPUT_TICK_MS    = 2;   // タッチ取得・慣性計算・デルタ送信の周期
+const int      INPUT_REF_TICKS  = 8;   // 係数を調整した元の 1ステップ(16ms) の tick 数
+const int      INPUT_TASK_PRIO  = 5;
+const int      INPUT_TASK_CORE  = 0;   // 描画(loop)はCore1
+
+portMUX_TYPE rotMux = portMUX_INITIALIZER_UNLOCKED;  // orientation 保護
+volatile bool modeChanged = false;   // BtnC → 描画側で画面リセット
+
+// ===== 遅延計測（タッチ取得 → Serial書き込み） =====
+// 表示用の 1秒窓は loop だけが持つ（入力タスクは下の受け渡しに積むだけ）
+bool     showLatency   = false;      // BtnBで表示切替
+uint32_t latLastUs = 0;
+uint32_t latMaxUs  = 0;
+uint32_t latSumUs  = 0;
+uint32_t latCount  = 0;
+uint32_t tickMaxUs = 0;              // 入力tick周期の最大値（ジッタ確認用）
+
+// ===== 入力タスク → 描画（loop）の受け渡し =====
+// 入力タスクはデルタ・クリック・計測値を積むだけ。
+// trailX/Y・clickFx・遅延窓の更新とリセットは loop が取り出してから行う
+portMUX_TYPE fxMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct InputFx {
+  int32_t  trailDX, trailDY;   // 前回取り出し以降のデルタ合計
+  int8_t   lastDX, lastDY;     // 直近のデルタ（トレイルの太さ）
+  bool     moved;
+  bool     click;
+  uint32_t latLastUs, latMaxUs, latSumUs, latCount;
+  uint32_t tickMaxUs;
+};
+InputFx inputFxPending = {};
+
 
 // =============================
 // ベクトル
@@ -74,6 +132,23 @@ struct Vec3 {
 };
 
 struct Vec2 { float x,y; };
+
+struct Quat {
+  float w, x, y, z;
+  Quat(float w=1, float x=0, float y=0, float z=0) : w(w), x(x), y(y), z(z) {}
+
+  Quat operator*(const Quat& q) const {
+    return Quat(w*q.w - x*q.x - y*q.y - z*q.z,
+                w*q.x + x*q.w + y*q.z - z*q.y,
+                w*q.y - x*q.z + y*q.w + z*q.x,
+                w*q.z + x*q.y - y*q.x + z*q.w);
+  }
+
+  void normalize() {
+    float m = sqrt(w*w+x*x+y*y+z*z);
+    if (m > 0) { w/=m; x/=m; y/=m; z/=m; }
+  }
+};
 Vec3 angularVel = {0,0,0};
 
 float dot(const Vec3& a,const Vec3& b){return a.x*b.x+a.y*b.y+a.z*b.z;}
@@ -81,20 +156,43 @@ Vec3 cross(const Vec3& a,const Vec3& b){
   return Vec3(a.y*b.z-a.z*b.y,a.z*b.x-a.x*b.z,a.x*b.y-a.y*b.x);
 }
 
+// 3x3回転行列（1フレーム1回だけ作る）
+struct Mat3 {
+  float m[3][3];
+
+  Vec3 operator*(const Vec3& v) const {
+    return Vec3(m[0][0]*v.x + m[0][1]*v.y + m[0][2]*v.z,
+                m[1][0]*v.x + m[1][1]*v.y + m[1][2]*v.z,
+                m[2][0]*v.x + m[2][1]*v.y + m[2][2]*v.z);
+  }
+};
+
 // =============================
 // Quad構造（★ここが重要）
 // =============================
 struct Quad {
-  int v[4];
+  uint16_t v[4];   // LOD内の頂点番号
   Vec3 center;
-  int team;   // 0:透明 1:緑
+  uint8_t team;    // 0:透明 1:緑
 };
 
-std::vector<Vec3> vertices;
-std::vector<Quad> quads;
+struct SphereLOD {
+  int grid;
+  const Vec3* vertices;
+  int vertexCount;
+  const Quad* quads;
+  int quadCount;
+};
+
+// 全LODのメッシュを起動時に1回だけ平坦な配列へ作る
+static Vec3 meshVertices[TOTAL_VERTS];
+static Quad meshQuads[TOTAL_QUADS];
+static SphereLOD lods[LOD_COUNT];
+
+volatile int currentLod = 1;   // 起動時は従来と同じ 8x8
 
-// ===== 回転（新方式） =====
-Vec3 rotAxis = {0, 0, 0};
+// ===== 回転（クォータニオン） =====
+Quat orientation;
 Vec3 stableAxis = {0,0,0};
 int lastTouchX = 0;
 int lastTouchY = 0;
@@ -105,12 +203,39 @@ bool touching = false;
 // =============================
 M5Canvas canvas(&M5.Display);
 
+// ===== 描画バッファ（起動時に確保、毎フレームのヒープ確保なし） =====
+struct ZKey { float z; int idx; };
+
+static float projX[MAX_LOD_VERTS];
+static float projY[MAX_LOD_VERTS];
+static float rotX[MAX_LOD_VERTS];
+static float rotY[MAX_LOD_VERTS];
+static float rotZ[MAX_LOD_VERTS];
+static ZKey  zsort[MAX_LOD_QUADS];
+
+// ===== 描画モード（BtnA） =====
+// CULLED: 裏面を捨てて前面だけ描く。凸な球なら前面同士は重ならないのでソート不要
+// SORTED: 従来どおり全面をZソートして奥から描く
+enum RenderMode : uint8_t {
+  RENDER_CULLED = 0,
+  RENDER_SORTED = 1,
+};
+
+volatile RenderMode renderMode = RENDER_CULLED;
+uint16_t frameQuads = 0;      // 実際に描いた面数
+
+// ===== フレーム計測 =====
+uint32_t frameRenderUs = 0;   // 変換〜ラスタライズ（push前）
+uint32_t framePeriodUs = 0;   // 前フレームからの周期
+
 // =============================
 // 球生成
 // =============================
-void createQuadSphere() {
-  vertices.clear();
-  quads.clear();
+// 1LOD分を out へ書き出す。面の境界（辺・角）の頂点は共有する
+SphereLOD createQuadSphere(int grid, Vec3* outVerts, Quad* outQuads) {
+  // 立方体表面の格子点 → 頂点番号（重複排除用、起動時のみ使用）
+  static int16_t lattice[MAX_GRID+1][MAX_GRID+1][MAX_GRID+1];
+  memset(lattice, 0xff, sizeof(lattice));
 
   Vec3 normals[] = {
     {1,0,0},{-1,0,0},{0,1,0},{0,-1,0},{0,0,1},{0,0,-1}
@@ -120,71 +245,247 @@ void createQuadSphere() {
     {0,1,0},{0,1,0},{1,0,0},{1,0,0},{1,0,0},{1,0,0}
   };
 
-  int offset = 0;
+  int vertexCount = 0;
+  int quadCount = 0;
+  uint16_t faceIdx[MAX_GRID+1][MAX_GRID+1];
 
   for (int f=0; f<6; f++) {
     Vec3 n = normals[f];
     Vec3 t = tangents[f];
     Vec3 b = cross(n,t);
 
-    for(int j=0;j<=GRID_SIZE;j++){
-      for(int i=0;i<=GRID_SIZE;i++){
-        float u = (float)i/GRID_SIZE*2-1;
-        float v = (float)j/GRID_SIZE*2-1;
-
-        Vec3 p = n + t*u + b*v;
-        p.normalize();
-        vertices.push_back(p*SPHERE_RADIUS);
+    for(int j=0;j<=grid;j++){
+      for(int i=0;i<=grid;i++){
+        // 格子座標は各軸 0..grid の整数になる
+        Vec3 c = n*grid + t*(2*i-grid) + b*(2*j-grid);
+        int lx = ((int)lroundf(c.x) + grid) / 2;
+        int ly = ((int)lroundf(c.y) + grid) / 2;
+        int lz = ((int)lroundf(c.z) + grid) / 2;
+
+        int16_t &slot = lattice[lx][ly][lz];
+        if (slot < 0) {
+          float u = (float)i/grid*2-1;
+          float v = (float)j/grid*2-1;
+
+          Vec3 p = n + t*u + b*v;
+          p.normalize();
+          outVerts[vertexCount] = p*SPHERE_RADIUS;
+          slot = vertexCount++;
+        }
+        faceIdx[j][i] = slot;
       }
     }
 
-    for(int j=0;j<GRID_SIZE;j++){
-      for(int i=0;i<GRID_SIZE;i++){
-        Quad q;
+    for(int j=0;j<grid;j++){
+      for(int i=0;i<grid;i++){
+        Quad &q = outQuads[quadCount++];
 
-        q.v[0]=offset+j*(GRID_SIZE+1)+i;
-        q.v[1]=offset+j*(GRID_SIZE+1)+i+1;
-        q.v[2]=offset+(j+1)*(GRID_SIZE+1)+i+1;
-        q.v[3]=offset+(j+1)*(GRID_SIZE+1)+i;
+        q.v[0]=faceIdx[j][i];
+        q.v[1]=faceIdx[j][i+1];
+        q.v[2]=faceIdx[j+1][i+1];
+        q.v[3]=faceIdx[j+1][i];
 
-        q.center = (vertices[q.v[0]]+
-                    vertices[q.v[1]]+
-                    vertices[q.v[2]]+
-                    vertices[q.v[3]])*0.25f;
+        q.center = (outVerts[q.v[0]]+
+                    outVerts[q.v[1]]+
+                    outVerts[q.v[2]]+
+                    outVerts[q.v[3]])*0.25f;
 
         // ★半分だけ緑
         q.team = (f < 3) ? 1 : 0;
-
-        quads.push_back(q);
       }
     }
+  }
+
+  SphereLOD lod;
+  lod.grid = grid;
+  lod.vertices = outVerts;
+  lod.vertexCount = vertexCount;   // = lodVertexCount(grid)
+  lod.quads = outQuads;
+  lod.quadCount = quadCount;
+  return lod;
+}
+
+void createSphereLODs() {
+  int vOfs = 0;
+  int qOfs = 0;
+
+  for (int l=0; l<LOD_COUNT; l++) {
+    lods[l] = createQuadSphere(LOD_GRID[l], meshVertices + vOfs, meshQuads + qOfs);
+    vOfs += lods[l].vertexCount;
+    qOfs += lods[l].quadCount;
+  }
+}
 
-    offset += (GRID_SIZE+1)*(GRID_SIZE+1);
+// 回転速度と直近の描画時間からLODを選ぶ
+//  - 速いほど粗く（ブレて細部は見えない）
+//  - 予算超過なら1段粗く、十分余裕があれば1段戻す
+int selectLod(float spinSpeed, uint32_t renderUs) {
+  static int budgetLod = 0;
+  static int calmFrames = 0;   // 戻すのは余裕が続いたときだけ（往復防止）
+
+  if (renderUs > LOD_RENDER_BUDGET_US) {
+    if (budgetLod < LOD_COUNT-1) budgetLod++;
+    calmFrames = 0;
+  } else if (renderUs < LOD_RENDER_BUDGET_US / 2) {
+    if (++calmFrames >= 60 && budgetLod > 0) {
+      budgetLod--;
+      calmFrames = 0;
+    }
+  } else {
+    calmFrames = 0;
   }
+
+  int speedLod;
+  if (spinSpeed < 0.05f)      speedLod = 0;
+  else if (spinSpeed < 0.30f) speedLod = 1;
+  else if (spinSpeed < 1.00f) speedLod = 2;
+  else                        speedLod = 3;
+
+  return max(speedLod, budgetLod);
 }
 
 // =============================
 // 回転
 // =============================
-Vec3 rotate(Vec3 v){
-  Vec3 axis = rotAxis;
-  axis.normalize();
+// 姿勢は正規化クォータニオンで保持し、角速度を1ステップごとに積分する
+Quat quatFromAxisAngle(const Vec3& axis, float angle){
+  float h = angle * 0.5f;
+  float s = sin(h);
+  return Quat(cos(h), axis.x*s, axis.y*s, axis.z*s);
+}
+
+// 単位クォータニオン → 回転行列（描画側で1フレーム1回）
+Mat3 quatToMatrix(const Quat& q){
+  float xx = q.x*q.x, yy = q.y*q.y, zz = q.z*q.z;
+  float xy = q.x*q.y, xz = q.x*q.z, yz = q.y*q.z;
+  float wx = q.w*q.x, wy = q.w*q.y, wz = q.w*q.z;
+
+  Mat3 r;
+  r.m[0][0] = 1 - 2*(yy + zz);
+  r.m[0][1] = 2*(xy - wz);
+  r.m[0][2] = 2*(xz + wy);
+
+  r.m[1][0] = 2*(xy + wz);
+  r.m[1][1] = 1 - 2*(xx + zz);
+  r.m[1][2] = 2*(yz - wx);
+
+  r.m[2][0] = 2*(xz - wy);
+  r.m[2][1] = 2*(yz + wx);
+  r.m[2][2] = 1 - 2*(xx + yy);
+  return r;
+}
+
+// 描画側は1フレーム分の姿勢をまとめて取り出す
+Quat snapshotOrientation(){
+  portENTER_CRITICAL(&rotMux);
+  Quat q = orientation;
+  portEXIT_CRITICAL(&rotMux);
+  return q;
+}
+
+void setOrientation(const Quat& q){
+  portENTER_CRITICAL(&rotMux);
+  orientation = q;
+  portEXIT_CRITICAL(&rotMux);
+}
+
+// 画面基準の角速度を球のローカル軸まわりの回転として積む
+// （旧方式の worldAxis = R*localAxis と同じ回転を右から掛ける）
+// =============================
+// tick 換算
+// =============================
+// 慣性・ゲインはもともと 16ms ステップで調整してあり、angularVel も
+// 「1ステップあたりの回転量」のまま持つ。毎tick回すので係数は tick 分に直す
+const float INPUT_TICK_K = 1.0f / INPUT_REF_TICKS;
+
+// 1ステップで f 倍になる減衰 → 1tick 分
+static inline float tickDecay(float f) {
+  return powf(f, INPUT_TICK_K);
+}
+
+// 1ステップで目標へ k だけ寄せるブレンド → 1tick 分
+static inline float tickBlend(float k) {
+  return 1.0f - powf(1.0f - k, INPUT_TICK_K);
+}
+
+// タッチ座標はパネル側の更新周期（tick より粗い）でしか変わらない。
+// 座標が変わった tick で「移動量 / 前回変化からの時間」を取り、
+// 元の単位（16ms あたりの px）に直して次の変化まで保持する
+static float    touchVelX = 0.0f;
+static float    touchVelY = 0.0f;
+static uint32_t touchMoveUs = 0;
+const uint32_t  TOUCH_STILL_US = 40000;   // これだけ変化が無ければ止まったとみなす
+
+void resetTouchVelocity() {
+  touchVelX = touchVelY = 0.0f;
+  touchMoveUs = micros();
+}
 
-  float angle = sqrt(rotAxis.x*rotAxis.x + rotAxis.y*rotAxis.y + rotAxis.z*rotAxis.z);
+void updateTouchVelocity(int rawDX, int rawDY) {
+  uint32_t now = micros();
+  uint32_t since = now - touchMoveUs;
 
-  if (angle < 0.0001f) return v;
+  if (rawDX != 0 || rawDY != 0) {
+    if (since < INPUT_TICK_MS * 1000) since = INPUT_TICK_MS * 1000;
+    if (since > TOUCH_STILL_US)       since = TOUCH_STILL_US;
 
-  float c = cos(angle);
-  float s = sin(angle);
+    float k = (INPUT_REF_TICKS * INPUT_TICK_MS * 1000.0f) / since;
+    touchVelX = rawDX * k;
+    touchVelY = rawDY * k;
+    touchMoveUs = now;
+  } else if (since > TOUCH_STILL_US) {
+    touchVelX = touchVelY = 0.0f;
+  }
+}
+
+// k = 1 で 1ステップ分の回転
+void applyAngularVel(float k){
+  float angle = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y) * k;
+
+  if (angle > 0.0001f) {
+    Vec3 localAxis = Vec3(angularVel.x, angularVel.y, 0) * (k / angle);
 
-  return v * c +
-         cross(axis, v) * s +
-         axis * dot(axis, v) * (1 - c);
+    Quat q = orientation * quatFromAxisAngle(localAxis, angle);
+    q.normalize();   // 積分誤差でノルムがずれないように毎回戻す
+    setOrientation(q);
+  }
 }
 
 // =============================
 // タッチ操作（トラックボール）
 // =============================
+// ---- 入力タスク側：描画へ渡すものを積む ----
+void publishClickFx() {
+  portENTER_CRITICAL(&fxMux);
+  inputFxPending.click = true;
+  portEXIT_CRITICAL(&fxMux);
+}
+
+void publishMouseFx(int dx, int dy) {
+  portENTER_CRITICAL(&fxMux);
+  inputFxPending.trailDX += dx;
+  inputFxPending.trailDY += dy;
+  inputFxPending.lastDX = dx;
+  inputFxPending.lastDY = dy;
+  inputFxPending.moved = true;
+  portEXIT_CRITICAL(&fxMux);
+}
+
+void publishLatency(uint32_t lat) {
+  portENTER_CRITICAL(&fxMux);
+  inputFxPending.latLastUs = lat;
+  if (lat > inputFxPending.latMaxUs) inputFxPending.latMaxUs = lat;
+  inputFxPending.latSumUs += lat;
+  inputFxPending.latCount++;
+  portEXIT_CRITICAL(&fxMux);
+}
+
+void publishTickPeriod(uint32_t period) {
+  portENTER_CRITICAL(&fxMux);
+  if (period > inputFxPending.tickMaxUs) inputFxPending.tickMaxUs = period;
+  portEXIT_CRITICAL(&fxMux);
+}
+
 void updateTouch(){
 
   auto t = M5.Touch.getDetail();
@@ -224,7 +525,7 @@ void updateTouch(){
       ) {
         Serial.print("CLICK\n");
         Serial.flush();
-        clickFx = 1.0f;
+        publishClickFx();
       }
     }
 
@@ -250,6 +551,7 @@ float inertia = 0.08f + speed * 0.18f;
 if (inertia > 0.88f) inertia = 0.88f;
 if (inertia < 0.05f) inertia = 0.05f;
 
+inertia = tickDecay(inertia);
 angularVel.x *= inertia;
 angularVel.y *= inertia;
 
@@ -257,18 +559,24 @@ angularVel.y *= inertia;
       touching = true;
       lastTouchX = t.x;
       lastTouchY = t.y;
+      resetTouchVelocity();
 
       // ★ returnしない
     }
 
-    int dx = t.x - lastTouchX;
-    int dy = t.y - lastTouchY;
+    int rawDX = t.x - lastTouchX;
+    int rawDY = t.y - lastTouchY;
 
-    tapTravel += abs(dx) + abs(dy);
+    tapTravel += abs(rawDX) + abs(rawDY);
 
     lastTouchX = t.x;
     lastTouchY = t.y;
 
+    // 以降の dx/dy は 16ms あたりの移動量
+    updateTouchVelocity(rawDX, rawDY);
+    float dx = touchVelX;
+    float dy = touchVelY;
+
     //float speed = sqrt(dx * dx + dy * dy);
 
     // ======================
@@ -293,12 +601,12 @@ else smooth = 0.42f;
 if (speed < 0.65f) {
 
   // BALL的精密制御
-  angularVel.x += dy * 0.10f;
-  angularVel.y += -dx * 0.10f;
+  angularVel.x += dy * 0.10f * INPUT_TICK_K;
+  angularVel.y += -dx * 0.10f * INPUT_TICK_K;
 
 if (speed < 0.65f) {
-  angularVel.x *= 0.92f;
-  angularVel.y *= 0.92f;
+  angularVel.x *= tickDecay(0.92f);
+  angularVel.y *= tickDecay(0.92f);
 }
 
 fxPrevX = fxX;
@@ -307,17 +615,16 @@ fxPrevY = fxY;
 fxX = t.x;
 fxY = t.y;
 
-float ddx = fxX - fxPrevX;
-float ddy = fxY - fxPrevY;
-
-fxPower = sqrt(ddx * ddx + ddy * ddy);
+// 1ステップ分の指の移動量
+fxPower = sqrt(dx * dx + dy * dy);
 fxTouch = true;
 
 } else {
 
   // 通常PAD
-  angularVel.x = angularVel.x * 0.35f + dy * gain * 0.65f;
-  angularVel.y = angularVel.y * 0.35f + -dx * gain * 0.65f;
+  float k = tickBlend(0.65f);
+  angularVel.x += (dy * gain - angularVel.x) * k;
+  angularVel.y += (-dx * gain - angularVel.y) * k;
 }
 
 
@@ -329,7 +636,7 @@ fxTouch = true;
   static float microY = 0;
 
   fxTouch = false;
-  fxPower *= 0.90f;
+  fxPower *= tickDecay(0.90f);
 
 int dx = t.x - lastTouchX;
 int dy = t.y - lastTouchY;
@@ -347,12 +654,12 @@ float outY = 0;
     // しきい値超えたら少しずつ出す
     if (fabs(microX) > 0.15f) {
       outX = microX * 0.25f;
-      microX *= 0.4f;
+      microX *= tickDecay(0.4f);
     }
 
     if (fabs(microY) > 0.15f) {
       outY = microY * 0.25f;
-      microY *= 0.4f;
+      microY *= tickDecay(0.4f);
     }
 
     angularVel.x = outY;
@@ -377,25 +684,26 @@ float outY = 0;
 
       angularVel = {0, 0, 0};
       stableAxis = {0, 0, 0};
-      rotAxis = {0, 0, 0};
+      setOrientation(Quat());
       movementStarted = false;
 
-      accDX = 0;
-      accDY = 0;
-
       lastTouchX = t.x;
       lastTouchY = t.y;
+      resetTouchVelocity();
 
       return; // 初回は差分なし
     }
 
     // ===== 差分取得 =====
-    int rawDX = t.x - lastTouchX;
-    int rawDY = t.y - lastTouchY;
+    updateTouchVelocity(t.x - lastTouchX, t.y - lastTouchY);
 
     lastTouchX = t.x;
     lastTouchY = t.y;
 
+    // 16ms あたりの移動量（係数の調整単位）
+    float rawDX = touchVelX;
+    float rawDY = touchVelY;
+
     // =========================
     // BALL 精密操作モード
     // 慣性OFF / 軸固定なし / PAD的な直入力
@@ -416,41 +724,21 @@ float outY = 0;
       if (rawSpeed < 0.4f) microGain = 0.055f;
 
       // PADと同じ感覚：指の動きをそのまま回転速度へ
-      angularVel.x = angularVel.x * 0.20f + rawDY * microGain;
-      angularVel.y = angularVel.y * 0.20f + -rawDX * microGain;
+      // （1ステップで 0.8 寄せる → 目標は rawD * microGain / 0.8）
+      float k = tickBlend(0.80f);
+      angularVel.x += (rawDY * microGain / 0.80f - angularVel.x) * k;
+      angularVel.y += (-rawDX * microGain / 0.80f - angularVel.y) * k;
 
       // 回転適用
-      Vec3 axisX = rotate({1,0,0});
-      Vec3 axisY = rotate({0,1,0});
-
-      Vec3 worldAxis = axisX * angularVel.x + axisY * angularVel.y;
-
-      float angle = sqrt(
-        angularVel.x * angularVel.x +
-        angularVel.y * angularVel.y
-      );
-
-      if (angle > 0.0001f) {
-        worldAxis.normalize();
-
-        rotAxis.x += worldAxis.x * angle;
-        rotAxis.y += worldAxis.y * angle;
-        rotAxis.z += worldAxis.z * angle;
-      }
+      applyAngularVel(INPUT_TICK_K);
 
       return;
     }
 
     ballPrecisionActive = false;
 
-    accDX += (float)rawDX;
-    accDY += (float)rawDY;
-
-    int dx = (int)accDX;
-    int dy = (int)accDY;
-
-    accDX -= dx;
-    accDY -= dy;
+    float dx = rawDX;
+    float dy = rawDY;
 
     float moveAmount = fabs(dx) + fabs(dy);
 
@@ -461,17 +749,13 @@ float outY = 0;
     }
 
     movementStarted = true;
-
-    // 初動ジャンプ防止を弱める
-    accDX *= 0.7f;
-    accDY *= 0.7f;
   }
 
     // ===== スピード =====
     float speed = sqrt(dx*dx + dy*dy);
 
     // ===== 軸生成 =====
-    Vec3 inputAxis = {(float)dy, (float)-dx, 0.0f};
+    Vec3 inputAxis = {dy, -dx, 0.0f};
 
     float len = sqrt(inputAxis.x*inputAxis.x + inputAxis.y*inputAxis.y);
     if (len > 0.0f) {
@@ -497,8 +781,9 @@ float outY = 0;
       stability = 0.92f;
     }
 
-    stableAxis.x = stableAxis.x * stability + inputAxis.x * (1.0f - stability);
-    stableAxis.y = stableAxis.y * stability + inputAxis.y * (1.0f - stability);
+    float ak = tickBlend(1.0f - stability);
+    stableAxis.x += (inputAxis.x - stableAxis.x) * ak;
+    stableAxis.y += (inputAxis.y - stableAxis.y) * ak;
 
     float slen = sqrt(stableAxis.x*stableAxis.x + stableAxis.y*stableAxis.y);
     if (slen > 0.0f) {
@@ -542,8 +827,8 @@ float outY = 0;
     if (speed < 0.5f) {
     // 何もしない（減衰しない）
     } else if (speed < 1.5f) {
-      angularVel.x *= 0.9f;
-      angularVel.y *= 0.9f;
+      angularVel.x *= tickDecay(0.9f);
+      angularVel.y *= tickDecay(0.9f);
     }
 
     // ===== 合成 =====
@@ -558,8 +843,9 @@ float outY = 0;
     }
 
 
-    angularVel.x = angularVel.x * (1.0f - follow) + axis.x * power * follow;
-    angularVel.y = angularVel.y * (1.0f - follow) + axis.y * power * follow;
+    float fk = tickBlend(follow);
+    angularVel.x += (axis.x * power - angularVel.x) * fk;
+    angularVel.y += (axis.y * power - angularVel.y) * fk;
     float directPower = 0.0f;
 
       if (v < 0.8f) {
@@ -573,26 +859,13 @@ float outY = 0;
     // ===== 微動補助 =====
     if (v < 1.2f) {
       float direct = (1.2f - v) / 1.2f;
-      angularVel.x += axis.x * direct * 0.10f;
-      angularVel.y += axis.y * direct * 0.10f;
+      angularVel.x += axis.x * direct * 0.10f * INPUT_TICK_K;
+      angularVel.y += axis.y * direct * 0.10f * INPUT_TICK_K;
     }
     
     
       // ===== 回転適用 =====
-    Vec3 axisX = rotate({1,0,0});
-    Vec3 axisY = rotate({0,1,0});
-
-    Vec3 worldAxis = axisX * angularVel.x + axisY * angularVel.y;
-
-    float angle = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y);
-
-    if (angle > 0.0001f) {
-      worldAxis.normalize();
-
-      rotAxis.x += worldAxis.x * angle;
-      rotAxis.y += worldAxis.y * angle;
-      rotAxis.z += worldAxis.z * angle;
-    }
+    applyAngularVel(INPUT_TICK_K);
 
   } else {
 
@@ -610,20 +883,7 @@ float outY = 0;
   // ===== 慣性 =====
   if(!touching){
 
-    Vec3 axisX = rotate({1,0,0});
-    Vec3 axisY = rotate({0,1,0});
-
-    Vec3 worldAxis = axisX * angularVel.x + axisY * angularVel.y;
-
-    float angle = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y);
-
-    if (angle > 0.0001f) {
-      worldAxis.normalize();
-
-      rotAxis.x += worldAxis.x * angle;
-      rotAxis.y += worldAxis.y * angle;
-      rotAxis.z += worldAxis.z * angle;
-    }
+    applyAngularVel(INPUT_TICK_K);
 
     float speed = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y);
 
@@ -632,6 +892,7 @@ float outY = 0;
     else if (speed > 1.0f) f = 0.70f;
     else f = 0.65f;
 
+    f = tickDecay(f);
     angularVel.x *= f;
     angularVel.y *= f;
 
@@ -640,7 +901,7 @@ float outY = 0;
   }
 }
 
-void drawCore() {
+void drawCore(const Mat3& R) {
 
   if (clickFx <= 0.01f) return;
 
@@ -651,7 +912,7 @@ void drawCore() {
   // 3D中心
   // =====================
   Vec3 corePos = {0,0,0};
-  Vec3 v = rotate(corePos);
+  Vec3 v = R * corePos;
 
   v.z += CAMERA_Z;
   if (v.z <= 0) return;
@@ -696,42 +957,62 @@ void drawSphere(){
 
   canvas.fillSprite(TFT_BLACK);
 
-  std::vector<Vec2> proj(vertices.size());
-  std::vector<Vec3> rotv(vertices.size());
+  // 入力タスクが回転を更新するので、フレーム頭で1回だけ取り出す
+  Quat rot = snapshotOrientation();
+
+  Mat3 R = quatToMatrix(rot);
+
+  // 極マーカーの点滅判定・LOD選択はフレームで1回
+  float speed = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y);
+
+  currentLod = selectLod(speed, frameRenderUs);
+  const SphereLOD &lod = lods[currentLod];
+  const Vec3* vertices = lod.vertices;
+  const Quad* quads = lod.quads;
 
-  // 頂点変換
-  for(size_t i=0;i<vertices.size();i++){
-    Vec3 v = rotate(vertices[i]);
+  uint32_t t0 = micros();
+
+  // 頂点変換（SoAバッファへ）
+  for(int i=0;i<lod.vertexCount;i++){
+    Vec3 v = R * vertices[i];
     v.z += CAMERA_Z;
 
+    rotX[i] = v.x;
+    rotY[i] = v.y;
+    rotZ[i] = v.z;
+
     if(v.z<=0){
-      proj[i]={-9999,-9999};
+      projX[i] = -9999;
+      projY[i] = -9999;
       continue;
     }
 
     float s = FOV/v.z;
 
-    proj[i].x = v.x*s + CANVAS_WIDTH/2;
-    proj[i].y = v.y*s + CANVAS_HEIGHT/2;
-
-    rotv[i]=v;
+    projX[i] = v.x*s + CANVAS_WIDTH/2;
+    projY[i] = v.y*s + CANVAS_HEIGHT/2;
   }
 
-  // Zソート
-  std::vector<std::pair<float,int>> zsort;
-  for(size_t i=0;i<quads.size();i++){
-    Vec3 c = rotate(quads[i].center);
-    zsort.push_back({c.z, i});
+  RenderMode mode = renderMode;
+
+  // Zソート（中心はz成分だけ使うので行列の3行目だけ掛ける）
+  if (mode == RENDER_SORTED) {
+    for(int i=0;i<lod.quadCount;i++){
+      const Vec3& c = quads[i].center;
+      zsort[i].z   = R.m[2][0]*c.x + R.m[2][1]*c.y + R.m[2][2]*c.z;
+      zsort[i].idx = i;
+    }
+    std::sort(zsort, zsort + lod.quadCount,
+              [](const ZKey& a, const ZKey& b) {
+                return a.z > b.z;
+              });
   }
-std::sort(zsort.begin(), zsort.end(),
-          [](const std::pair<float,int>& a,
-             const std::pair<float,int>& b) {
-            return a.first > b.first;
-          });
+
+  uint16_t drawn = 0;
 
   // 描画
-  for(auto &p:zsort){
-    Quad &q = quads[p.second];
+  for(int k=0;k<lod.quadCount;k++){
+    const Quad &q = quads[(mode == RENDER_SORTED) ? zsort[k].idx : k];
 
     // ★透明は描かない
     //if(q.team==0) continue;
@@ -740,8 +1021,9 @@ std::sort(zsort.begin(), zsort.end(),
     Vec3 rv[4];
 
     for(int i=0;i<4;i++){
-      pt[i]=proj[q.v[i]];
-      rv[i]=rotv[q.v[i]];
+      int vi = q.v[i];
+      pt[i] = {projX[vi], projY[vi]};
+      rv[i] = Vec3(rotX[vi], rotY[vi], rotZ[vi]);
     }
 
     if(pt[0].x==-9999) continue;
@@ -750,14 +1032,17 @@ std::sort(zsort.begin(), zsort.end(),
     Vec3 e2 = rv[2]-rv[0];
     Vec3 n  = cross(e1,e2);
 
-    // 裏面
+    // 裏面（法線が視点=原点を向いていなければ捨てる）
+    if (mode == RENDER_CULLED && dot(n, rv[0]) >= 0) continue;
 
+    drawn++;
 
 float shade = (rv[0].z - CAMERA_Z)/SPHERE_RADIUS;
 shade = constrain(shade,0,1);
 
-float glow = pow(shade, 2.0f);
-float rim  = pow(1.0f - fabs(n.z), 3.0f);
+float glow = shade * shade;
+float rimBase = 1.0f - fabs(n.z);
+float rim  = rimBase * rimBase * rimBase;
 
 uint8_t g = 120 + glow * 135 + rim * 120;
 uint8_t b = glow * 80;
@@ -777,8 +1062,6 @@ if (pole > 0.6f) {
   uint8_t r = t * 40;
   uint8_t b = t * 10;
 
-  float speed = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y);
-
   if (speed > 0.2f && random(0,100) < 30) {
     g = constrain(g + 100, 0, 255); // メイン発光
     r = constrain(r + 20, 0, 255);  // 少しだけ暖色
@@ -795,8 +1078,6 @@ if (pole < -0.6f) {
   uint8_t r = 0;
   uint8_t b = t * 30;  // ←青をかなり抑える
 
-  float speed = sqrt(angularVel.x*angularVel.x + angularVel.y*angularVel.y);
-
   if (speed > 0.2f && random(0,100) < 30) {
     g = constrain(g + 100, 0, 255);
     // bはほぼ上げない
@@ -843,10 +1124,17 @@ Vec3 base = vertices[q.v[0]];
 // CLICK CORE ONLY
 // =====================
 if (clickFx > 0.01f) {
-  drawCore();
+  drawCore(R);
 }
 
 
+  frameRenderUs = micros() - t0;
+  frameQuads = drawn;
+
+  static uint32_t lastFrameUs = 0;
+  framePeriodUs = t0 - lastFrameUs;
+  lastFrameUs = t0;
+
   canvas.pushSprite(
     (M5.Display.width()-CANVAS_WIDTH)/2,
     (M5.Display.height()-CANVAS_HEIGHT)/2
@@ -1008,21 +1296,22 @@ void drawCursorTrailFX() {
 //     SerialBT.write((int8_t)dy);
 //   }
 // }
-void sendMouseDelta() {
-  static float accumX = 0.0f;
-  static float accumY = 0.0f;
+static float mouseAccumX = 0.0f;
+static float mouseAccumY = 0.0f;
+
+// この tick の移動量
+static float mouseTickX = 0.0f;
+static float mouseTickY = 0.0f;
 
+// 入力tickごとに呼ぶ：この tick の移動量を決める
+void updateMouseStep() {
   static float outX = 0;
   static float outY = 0;
+  static int   slowTicks = 0;
 
-  outX = outX * 0.65f + accumX * 0.35f;
-  outY = outY * 0.65f + accumY * 0.35f;
-
-  int dx = (int)round(outX);
-  int dy = (int)round(outY);
-
-  // 疑似高Hz化: 1フレームの移動を複数サブステップに分ける
-  const int subSteps = 2;
+  float ok = tickBlend(0.35f);
+  outX += (mouseAccumX - outX) * ok;
+  outY += (mouseAccumY - outY) * ok;
 
   float speed = sqrt(angularVel.x * angularVel.x + angularVel.y * angularVel.y);
 
@@ -1038,54 +1327,235 @@ float scale = 14.0f / (1.0f + speed * 0.75f);
 
 if (scale < 4.2f) scale = 4.2f;
 
-  // 1フレーム分の移動量
+  // 1ステップ分の移動量
   float frameMoveX = -angularVel.y * scale * 1.6f;
   float frameMoveY =  angularVel.x * scale * 1.6f;
 
-  // サブステップに分割して accum に積む
+  // 低速域の端数は元どおり 1ステップ(16ms)ごとに捨てる
+  // （毎tick捨てると微動が一切出なくなる）
   if (fabs(angularVel.x) < 0.03f &&
     fabs(angularVel.y) < 0.03f) {
-    accumX = 0;
-    accumY = 0;
+    if (slowTicks++ % INPUT_REF_TICKS == 0) {
+      mouseAccumX = 0;
+      mouseAccumY = 0;
+    }
+  } else {
+    slowTicks = 0;
   }
 
-  for (int i = 0; i < subSteps; i++) {
-    accumX += frameMoveX / subSteps;
-    accumY += frameMoveY / subSteps;
+  // 1ステップ分の移動を tick 分に
+  mouseTickX = frameMoveX * INPUT_TICK_K;
+  mouseTickY = frameMoveY * INPUT_TICK_K;
+}
+
+// 入力tickごとに呼ぶ：溜まった分を整数デルタで送信
+// sampleUs: この tick で取った移動サンプルの取得時刻（無ければ 0）
+void sendMouseDelta(uint32_t sampleUs) {
+  mouseAccumX += mouseTickX;
+  mouseAccumY += mouseTickY;
+
+  int dx = (int)round(mouseAccumX);
+  int dy = (int)round(mouseAccumY);
+
+  // 微動アシスト
+  if (dx == 0 && fabs(mouseAccumX) > 0.42f) {
+    dx = (mouseAccumX > 0) ? 1 : -1;
+  }
+  if (dy == 0 && fabs(mouseAccumY) > 0.42f) {
+    dy = (mouseAccumY > 0) ? 1 : -1;
+  }
+
+  mouseAccumX -= dx;
+  mouseAccumY -= dy;
+
+  if (dx == 0 && dy == 0) return;
+
+  Serial.write(0x30);
+  Serial.write((int8_t)dx);
+  Serial.write((int8_t)dy);
+
+  // タッチ取得 → USB送出までの遅延
+  // この tick のサンプルから計算したデルタを書いた時だけ数える
+  if (sampleUs != 0) publishLatency(micros() - sampleUs);
+
+  publishMouseFx(dx, dy);
+
+  if (SerialBT.hasClient()) {
+    SerialBT.write(0x30);
+    SerialBT.write((int8_t)dx);
+    SerialBT.write((int8_t)dy);
+  }
+}
+
+// =============================
+// 入力状態リセット（BtnC）
+// =============================
+void resetInputState() {
+  padMode = !padMode;
+
+  touching = false;
+  movementStarted = false;
+
+  angularVel = {0,0,0};
+  setOrientation(Quat());
+  stableAxis = {0,0,0};
+
+  mouseAccumX = mouseAccumY = 0;
+  mouseTickX  = mouseTickY  = 0;
+
+  fxX = 160;
+  fxY = 120;
+  fxPrevX = 160;
+  fxPrevY = 120;
+
+  fxPower = 0;
+  fxTouch = false;
+
+  tapArmed = false;
+  // trailX/Y・clickFx は modeChanged を見た loop が戻す
+}
 
-    int dx = (int)round(accumX);
-    int dy = (int)round(accumY);
+// この tick のタッチが移動を伴う新しいサンプルか
+bool isTouchMoveSample() {
+  static int prevX = -1;
+  static int prevY = -1;
 
-    // 微動アシスト
-    if (dx == 0 && fabs(accumX) > 0.42f) {
-      dx = (accumX > 0) ? 1 : -1;
+  auto t = M5.Touch.getDetail();
+  if (!t.isPressed()) {
+    prevX = prevY = -1;
+    return false;
+  }
+
+  bool moved = false;
+  if (t.x != prevX || t.y != prevY) {
+    moved = (prevX >= 0);
+    prevX = t.x;
+    prevY = t.y;
+  }
+  return moved;
+}
+
+// =============================
+// 入力タスク
+// =============================
+void inputTask(void* arg) {
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t prevTickUs = micros();
+
+  while (true) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(INPUT_TICK_MS));
+
+    uint32_t nowUs = micros();
+    uint32_t period = nowUs - prevTickUs;
+    prevTickUs = nowUs;
+    publishTickPeriod(period);
+
+    // タッチ/ボタンはここだけで更新する（loopでは呼ばない）
+    M5.update();
+
+    if (M5.BtnC.wasPressed()) {
+      resetInputState();
+      modeChanged = true;
+    }
+    if (M5.BtnB.wasPressed()) {
+      showLatency = !showLatency;
     }
-    if (dy == 0 && fabs(accumY) > 0.42f) {
-      dy = (accumY > 0) ? 1 : -1;
+    if (M5.BtnA.wasPressed()) {
+      renderMode = (renderMode == RENDER_CULLED) ? RENDER_SORTED : RENDER_CULLED;
     }
 
-    accumX -= dx;
-    accumY -= dy;
-
-    if (dx != 0 || dy != 0) {
-      Serial.write(0x30);
-      Serial.write((int8_t)dx);
-      Serial.write((int8_t)dy);
-      
-      trailVX = dx;
-      trailVY = dy;
-      trailX += dx * 6.0f;
-      trailY += dy * 6.0f;
-      // 範囲制限
-      trailX = constrain(trailX, 20, 300);
-      trailY = constrain(trailY, 20, 220);
-
-      if (SerialBT.hasClient()) {
-        SerialBT.write(0x30);
-        SerialBT.write((int8_t)dx);
-        SerialBT.write((int8_t)dy);
-      }
+    // サンプル取得時刻は M5.update()（タッチ読み出し）直前の nowUs
+    bool moved = isTouchMoveSample();
+
+    updateTouch();
+    updateMouseStep();
+    sendMouseDelta(moved ? nowUs : 0);
+  }
+}
+
+// =============================
+// loop 側：入力タスクが積んだものを取り出して反映
+// =============================
+void drainInputFx() {
+  portENTER_CRITICAL(&fxMux);
+  InputFx in = inputFxPending;
+  inputFxPending = {};
+  portEXIT_CRITICAL(&fxMux);
+
+  if (in.moved) {
+    trailVX = in.lastDX;
+    trailVY = in.lastDY;
+    trailX = constrain(trailX + in.trailDX * 6.0f, 20, 300);
+    trailY = constrain(trailY + in.trailDY * 6.0f, 20, 220);
+  }
+  // フラッシュはフレームごとに半減。新しいクリックは減衰後に立てて 1.0 から見せる
+  clickFx *= 0.5f;
+  if (clickFx < 0.01f) clickFx = 0.0f;
+  if (in.click) clickFx = 1.0f;
+
+  if (in.latCount) {
+    latLastUs = in.latLastUs;
+    if (in.latMaxUs > latMaxUs) latMaxUs = in.latMaxUs;
+    latSumUs += in.latSumUs;
+    latCount += in.latCount;
+  }
+  if (in.tickMaxUs > tickMaxUs) tickMaxUs = in.tickMaxUs;
+}
+
+// =============================
+// 遅延表示（BtnB）
+// =============================
+void drawLatencyOverlay() {
+  static bool wasShown = false;
+  static uint32_t lastDrawMs = 0;
+
+  if (!showLatency) {
+    if (wasShown) {
+      M5.Display.fillRect(0, 0, 58, 88, TFT_BLACK);
+      wasShown = false;
     }
+    return;
+  }
+
+  uint32_t now = millis();
+  // PADモードは毎フレーム全面クリアされるので毎回描く
+  if (wasShown && !padMode && now - lastDrawMs < 250) return;
+  lastDrawMs = now;
+  wasShown = true;
+
+  uint32_t avg = latCount ? latSumUs / latCount : 0;
+
+  M5.Display.setTextSize(1);
+  M5.Display.setTextColor(TFT_GREEN, TFT_BLACK);
+  M5.Display.setCursor(2, 2);
+  M5.Display.printf("LAT%5lu", (unsigned long)latLastUs);
+  M5.Display.setCursor(2, 12);
+  M5.Display.printf("AVG%5lu", (unsigned long)avg);
+  M5.Display.setCursor(2, 22);
+  M5.Display.printf("MAX%5lu", (unsigned long)latMaxUs);
+  M5.Display.setCursor(2, 32);
+  M5.Display.printf("TCK%5lu", (unsigned long)tickMaxUs);
+
+  if (!padMode) {
+    uint32_t fps = framePeriodUs ? 1000000UL / framePeriodUs : 0;
+    M5.Display.setCursor(2, 48);
+    M5.Display.printf("FPS%5lu", (unsigned long)fps);
+    M5.Display.setCursor(2, 58);
+    M5.Display.printf("RND%5lu", (unsigned long)frameRenderUs);
+    M5.Display.setCursor(2, 68);
+    M5.Display.printf("%s%5u", renderMode == RENDER_CULLED ? "CUL" : "SRT", frameQuads);
+    M5.Display.setCursor(2, 78);
+    M5.Display.printf("LOD%5d", LOD_GRID[currentLod]);
+  }
+
+  // 1秒窓ごとに最大値を更新し直す
+  static uint32_t windowMs = 0;
+  if (now - windowMs >= 1000) {
+    windowMs = now;
+    latMaxUs = 0;
+    latSumUs = 0;
+    latCount = 0;
+    tickMaxUs = 0;
   }
 }
 
@@ -1101,41 +1571,35 @@ void setup(){
 
   Serial.begin(115200); 
 
-  createQuadSphere();
+  createSphereLODs();
+
+  xTaskCreatePinnedToCore(
+    inputTask,
+    "inputTask",
+    4096,
+    NULL,
+    INPUT_TASK_PRIO,
+    NULL,
+    INPUT_TASK_CORE
+  );
 }
 
 // =============================
-// LOOP
+// LOOP（描画のみ）
 // =============================
 void loop(){
-  M5.update();
 
-  if (M5.BtnC.wasPressed()) {
+  drainInputFx();
 
-  padMode = !padMode;
-
-  touching = false;
-  movementStarted = false;
-
-  angularVel = {0,0,0};
-  rotAxis    = {0,0,0};
-  stableAxis = {0,0,0};
+  if (modeChanged) {
+    modeChanged = false;
 
+  // 入力側のリセットに合わせて描画側の演出状態も戻す
   trailX  = 160;
   trailY  = 120;
   trailVX = 0;
   trailVY = 0;
-
-  fxX = 160;
-  fxY = 120;
-  fxPrevX = 160;
-  fxPrevY = 120;
-
-  fxPower = 0;
-  fxTouch = false;
-
   clickFx = 0;
-  tapArmed = false;
 
   // ★ここ重要
   M5.Display.startWrite();
@@ -1148,18 +1612,12 @@ void loop(){
   delay(20);
 }
 
-updateTouch();
-
-// ★追加
-clickFx *= 0.5f;
-if (clickFx < 0.01f) clickFx = 0.0f;
-
 if (!padMode) {
   drawSphere();
 } else {
   drawCursorTrailFX();
 }
-  sendMouseDelta();  
+  drawLatencyOverlay();
 
   delay(5);
-}
\ No newline at end of file
+}
@@ -45,6 +45,7 @@ from serial.tools import list_ports
 import json
 import os
 import re
+import struct
 from tkinter.scrolledtext import ScrolledText
 
 import psutil
@@ -81,6 +82,57 @@ DEVICE_ID_LEN = 6
 
 CORE2_DEVICE_TYPE = 0x01
 
+# DEVICE_ID features ビット
+FEATURE_PCX = 0x08          # 拡張PCステータス（TLV）対応
+
+# probe で分かった features をポート名で覚えておく
+DEVICE_FEATURES = {}
+
+
+# ================================
+# 拡張PCステータス（TLV）
+# ================================
+# 0x40 [ver] [len] [TLV...] [sum8]
+#   TLV = [type] [bytes] [uint16 LE × n]
+#   sum8 = ver + len + TLV の 8bit 和
+# Core2 側は未知の type を読み飛ばすが、len は Core2 の項目表で出せる最大長までしか受けない
+PCX_HEADER  = 0x40
+PCX_VERSION = 0x01
+
+PCX_CPU      = 0x01   # 0.1%
+PCX_RAM      = 0x02   # 0.1%
+PCX_DISK     = 0x03   # 0.1%
+PCX_DISK_R   = 0x04   # 0.1MB/s
+PCX_DISK_W   = 0x05   # 0.1MB/s
+PCX_CORES    = 0x06   # 0.1% × コア数
+PCX_TEMPS    = 0x07   # 0.1℃ (符号付き) × センサ数
+PCX_NET_RX   = 0x08   # KB/s
+PCX_NET_TX   = 0x09   # KB/s
+
+PCX_MAX_CORES = 16
+PCX_MAX_TEMPS = 8
+
+
+def build_pcx_frame(fields):
+    """
+    [(type, [値, ...]), ...] から拡張フレームを組み立てる
+    """
+    payload = bytearray()
+    for t, values in fields:
+        if t == PCX_TEMPS:
+            body = b"".join(struct.pack("<h", max(-32768, min(32767, int(v)))) for v in values)
+        else:
+            body = b"".join(struct.pack("<H", max(0, min(0xFFFF, int(v)))) for v in values)
+        payload += bytes([t, len(body)]) + body
+
+    if len(payload) > 255:
+        raise ValueError("PCX payload too long")
+
+    head = bytes([PCX_VERSION, len(payload)])
+    return (bytes([PCX_HEADER]) + head
+            + bytes(payload)
+            + bytes([(sum(head) + sum(payload)) & 0xFF]))
+
 
 def probe_core2_bt_passive(port: str, wait=0.4):
     """
@@ -161,6 +213,7 @@ def probe_core2_port(port: str, timeout=0.15):
 
                 # deviceType == Core2 ?
                 if pkt[3] == CORE2_DEVICE_TYPE:
+                    DEVICE_FEATURES[port] = pkt[4]
                     ser.close()
                     return True
 
@@ -294,6 +347,7 @@ class SerialSender:
         self.ser = None
         self.lock = threading.Lock()
         self.is_bluetooth = False 
+        self.features = 0
 
 
     
@@ -335,6 +389,11 @@ class SerialSender:
                 write_timeout=0.05 if self.is_bluetooth else 0
             )
 
+            # features は probe 済みならそれを使い、応答が来たら上書き
+            self.features = DEVICE_FEATURES.get(port, 0)
+            if not self.is_bluetooth:
+                self.ser.write(bytes([HELLO_MAGIC, HELLO_CMD]))
+
               # 🔽 BT の場合だけ HELLO 待ち
             if self.is_bluetooth:
                 time.sleep(0.5)           # ← 超重要
@@ -430,36 +489,83 @@ class SerialSender:
         with self.lock:
             self.ser = ser
             self.is_bluetooth = is_bluetooth
+            self.features = DEVICE_FEATURES.get(ser.port, 0)
 
-    def send_pc_status(self, stats, disk_r_mb, disk_w_mb):
+    def on_device_id(self, ser, pkt):
         """
-        PC Status を Core2 に送信
+        受信スレッドが拾った DEVICE_ID 応答で features を更新
+        （ポートを読むのは受信スレッドだけ。ここでは読まない）
         """
-        if not self.is_connected():
+        if pkt[3] != CORE2_DEVICE_TYPE:
+            return
+        with self.lock:
+            if ser is not self.ser:
+                return          # 切り替え前のポートの応答
+            self.features = pkt[4]
+            DEVICE_FEATURES[ser.port] = pkt[4]
+
+    def send_pc_status(self, values):
+        """
+        PC Status を Core2 に送信（渡された項目だけ）
+        values: {"cpu": %, "ram": %, "disk": %, "disk_r": MB/s, "disk_w": MB/s,
+                 "net_rx": KB/s, "net_tx": KB/s, "cores": [%...], "temps": [℃...]}
+        拡張フレーム対応機なら TLV 1本、そうでなければ従来の 1byte 形式をまとめて 1回で書く
+        """
+        if not self.is_connected() or not values:
+            return
+
+        if self.features & FEATURE_PCX:
+            self.send_pc_status_ext(values)
             return
 
         def clamp(v, lo=0, hi=255):
             return max(lo, min(hi, int(v)))
 
-               # ---- 量子化 ----
-        r_mbps_q = clamp(disk_r_mb * 10)   # 0.1MB/s 単位
-        w_mbps_q = clamp(disk_w_mb * 10) 
-
-        packets = [
-            (0x20, clamp(stats["cpu_usage"])),
-            (0x21, clamp(stats["ram_usage"])),
-            (0x22, clamp(stats["disk_usage"])),
-            (0x23, clamp(disk_r_mb)),   # MB/s
-            (0x24, clamp(disk_w_mb)),
-            (0x25, r_mbps_q),                     # ★ MB/s 実値
-            (0x26, w_mbps_q),                     # ★ MB/s 実値
+        packets = []
+        if "cpu" in values:
+            packets.append((0x20, clamp(values["cpu"])))
+        if "ram" in values:
+            packets.append((0x21, clamp(values["ram"])))
+        if "disk" in values:
+            packets.append((0x22, clamp(values["disk"])))
+        if "disk_r" in values:
+            packets.append((0x23, clamp(values["disk_r"])))        # MB/s
+            packets.append((0x25, clamp(values["disk_r"] * 10)))   # ★ 0.1MB/s 単位
+        if "disk_w" in values:
+            packets.append((0x24, clamp(values["disk_w"])))
+            packets.append((0x26, clamp(values["disk_w"] * 10)))
+        if values.get("temps"):
+            packets.append((0x27, clamp(values["temps"][0], 0, 100)))
+
+        if packets:
+            self._write(b"".join(bytes([cmd, val]) for cmd, val in packets))
+
+    def send_pc_status_ext(self, values):
+        """
+        拡張PCステータス（16bit 値・コア別CPU・温度・ネットワーク）
+        """
+        scalars = [
+            ("cpu",    PCX_CPU,    10),
+            ("ram",    PCX_RAM,    10),
+            ("disk",   PCX_DISK,   10),
+            ("disk_r", PCX_DISK_R, 10),
+            ("disk_w", PCX_DISK_W, 10),
+            ("net_rx", PCX_NET_RX, 1),
+            ("net_tx", PCX_NET_TX, 1),
         ]
 
-        if stats.get("cpu_temp") is not None:
-            packets.append((0x27, clamp(stats["cpu_temp"], 0, 100)))
+        fields = []
+        for key, t, scale in scalars:
+            if key in values:
+                fields.append((t, [values[key] * scale]))
 
-        for cmd, val in packets:
-            self._write(bytes([cmd, val]))
+        if values.get("cores"):
+            fields.append((PCX_CORES, [c * 10 for c in values["cores"][:PCX_MAX_CORES]]))
+        if values.get("temps"):
+            fields.append((PCX_TEMPS, [t * 10 for t in values["temps"][:PCX_MAX_TEMPS]]))
+
+        if fields:
+            self._write(build_pcx_frame(fields))
 
 
     def send_mouse_motion(self, dx: int, dy: int):
@@ -750,8 +856,9 @@ class PCStatsCollector:
     def collect(self):
         stats = {}
 
-        # CPU
+        # CPU（全体＋コア別）
         stats["cpu_usage"] = int(psutil.cpu_percent(interval=None))
+        stats["cpu_per_core"] = psutil.cpu_percent(interval=None, percpu=True)
 
         # RAM
         mem = psutil.virtual_memory()
@@ -766,13 +873,15 @@ class PCStatsCollector:
 
         # 温度（取れない環境も多い）
         stats["cpu_temp"] = None
+        stats["temps"] = []
         try:
             temps = psutil.sensors_temperatures()
             if temps:
                 for name, entries in temps.items():
-                    if entries:
-                        stats["cpu_temp"] = int(entries[0].current)
-                        break
+                    for e in entries:
+                        stats["temps"].append(e.current)
+                if stats["temps"]:
+                    stats["cpu_temp"] = int(stats["temps"][0])
         except Exception:
             pass
 
@@ -812,6 +921,188 @@ class DiskIOMeter:
         return read_mb_s, write_mb_s
 
 
+# ================================
+# PC Stats 送信スレッド（変化分だけ送る）
+# ================================
+PCSTATS_DEFAULTS = {
+    "interval": 0.5,      # 秒。サンプリング周期
+    "keepalive": 10.0,    # 秒。変化が無くてもこの間隔で全項目を送る
+    # 前回送信値からこれ以上動いたら送る（各項目の単位で）
+    "hysteresis": {
+        "cpu": 2, "ram": 1, "disk": 1,
+        "disk_r": 0.5, "disk_w": 0.5,
+        "net_rx": 8, "net_tx": 8,
+        "cores": 5, "temps": 1,
+    },
+}
+
+
+def load_pcstats_config():
+    cfg = json.loads(json.dumps(PCSTATS_DEFAULTS))
+    if not os.path.exists(CONFIG_FILE):
+        return cfg
+    try:
+        with open(CONFIG_FILE, "r", encoding="utf-8") as f:
+            d = json.load(f).get("pcstats", {})
+        cfg["interval"]  = max(0.1, float(d.get("interval", cfg["interval"])))
+        cfg["keepalive"] = max(1.0, float(d.get("keepalive", cfg["keepalive"])))
+        cfg["hysteresis"].update(d.get("hysteresis", {}))
+    except Exception:
+        pass
+    return cfg
+
+
+class PCStatsWorker:
+    """
+    専用スレッドで PC Stats をサンプリングし、
+    ヒステリシスを超えた項目だけを 1フレームにまとめて送る
+    """
+
+    def __init__(self, sender, config=None):
+        self.sender = sender
+        self.config = config or load_pcstats_config()
+
+        self.collector = PCStatsCollector()
+        self.disk_io = DiskIOMeter()
+        self.net_io = NetIOMeter()
+
+        self.lock = threading.Lock()
+        self.latest = None          # GUI 表示用（最新サンプル）
+        self.last_sent = {}
+        self.last_full = 0.0
+        self.last_ser = None
+
+        # 送信統計
+        self.samples = 0
+        self.frames = 0
+        self.fields_sent = 0
+        self.fields_skipped = 0
+
+        self.running = False
+        self.thread = None
+        self._wake = threading.Event()
+
+    def start(self):
+        if self.running:
+            return
+        self.running = True
+        self.thread = threading.Thread(target=self._loop, daemon=True)
+        self.thread.start()
+
+    def stop(self):
+        self.running = False
+        self._wake.set()
+
+    def get_latest(self):
+        with self.lock:
+            return self.latest
+
+    def get_stats(self):
+        """送信統計（GUI 表示用）"""
+        with self.lock:
+            return {
+                "samples": self.samples,
+                "frames": self.frames,
+                "sent": self.fields_sent,
+                "skipped": self.fields_skipped,
+            }
+
+    def _sample(self):
+        stats = self.collector.collect()
+        r_mb, w_mb = self.disk_io.update()
+        rx, tx = self.net_io.update()
+        return {
+            "cpu": stats["cpu_usage"],
+            "ram": stats["ram_usage"],
+            "disk": stats["disk_usage"],
+            "disk_r": r_mb,
+            "disk_w": w_mb,
+            "net_rx": rx,
+            "net_tx": tx,
+            "cores": stats["cpu_per_core"],
+            "temps": stats["temps"],
+        }
+
+    def _changed(self, key, value):
+        if key not in self.last_sent:
+            return True
+        prev = self.last_sent[key]
+        h = self.config["hysteresis"].get(key, 0)
+
+        if isinstance(value, list):
+            if len(value) != len(prev):
+                return True
+            return any(abs(a - b) >= h for a, b in zip(value, prev))
+        return abs(value - prev) >= h
+
+    def _loop(self):
+        while self.running:
+            t0 = time.time()
+            sample = self._sample()
+
+            with self.lock:
+                self.latest = sample
+                self.samples += 1
+
+            # 接続し直したら Core2 側は空なので全項目を送る
+            ser = self.sender.ser
+            full = (ser is not self.last_ser) or (t0 - self.last_full >= self.config["keepalive"])
+
+            if full:
+                delta = dict(sample)
+                self.last_full = t0
+                self.last_ser = ser
+            else:
+                delta = {k: v for k, v in sample.items() if self._changed(k, v)}
+
+            with self.lock:
+                self.fields_skipped += len(sample) - len(delta)
+
+            if delta and self.sender.is_connected():
+                self.sender.send_pc_status(delta)
+                self.last_sent.update(delta)
+                with self.lock:
+                    self.frames += 1
+                    self.fields_sent += len(delta)
+
+            wait = self.config["interval"] - (time.time() - t0)
+            if wait > 0:
+                self._wake.wait(wait)
+
+
+class NetIOMeter:
+    """
+    ネットワーク送受信を 1秒差分で KB/s に変換する
+    """
+    def __init__(self):
+        self.prev_rx = None
+        self.prev_tx = None
+        self.prev_time = None
+
+    def update(self):
+        now = time.time()
+        io = psutil.net_io_counters()
+
+        if self.prev_time is None:
+            self.prev_rx = io.bytes_recv
+            self.prev_tx = io.bytes_sent
+            self.prev_time = now
+            return 0.0, 0.0
+
+        dt = now - self.prev_time
+        if dt <= 0:
+            return 0.0, 0.0
+
+        rx_kb_s = (io.bytes_recv - self.prev_rx) / 1024 / dt
+        tx_kb_s = (io.bytes_sent - self.prev_tx) / 1024 / dt
+
+        self.prev_rx = io.bytes_recv
+        self.prev_tx = io.bytes_sent
+        self.prev_time = now
+
+        return rx_kb_s, tx_kb_s
+
+
 # ================================
 # Serial port auto selection
 # ================================
@@ -871,18 +1162,20 @@ class TypingMeterApp:
         self.root.geometry("450x550")
         self._pressed_keys = set()
         self._auto_reconnect_enabled = True
+        self._rx_thread_started = False
 
-        self.pcstats = PCStatsCollector()
+        self.pcstats = PCStatsWorker(self.sender)
+        self.pcstats.start()
 
         self.cpu_var  = tk.StringVar(value="--")
         self.ram_var  = tk.StringVar(value="--")
         self.disk_var = tk.StringVar(value="--")
         self.temp_var = tk.StringVar(value="--")
 
-        self.disk_io = DiskIOMeter()
 
         self.disk_r_var = tk.StringVar(value="0.0 MB/s")
         self.disk_w_var = tk.StringVar(value="0.0 MB/s")
+        self.pcstats_tx_var = tk.StringVar(value="--")
 
         self.always_on_top = tk.BooleanVar(value=True)
         # 起動時に最前面設定を反映
@@ -966,11 +1259,76 @@ class TypingMeterApp:
         self.root.protocol("WM_DELETE_WINDOW", self.on_close)
     
     # -----------------------------
-    # マウスレポート受信 部分
+    # Core2 からの受信 部分
     # -----------------------------
-   
+    # ポートを読むのはこのスレッドだけ。
+    # CLICK\n / マウス移動 (0x30 dx dy) / DEVICE_ID (0x7F 0x01 ...) を先頭から順に切り分ける
+
+    def start_receiver(self):
+        if self._rx_thread_started:
+            return
+        self._rx_thread_started = True
+        threading.Thread(
+            target=self.mouse_receiver_loop,
+            daemon=True
+        ).start()
+
+    def _dispatch_rx(self, ser, rx_buf):
+        while rx_buf:
+            # -------------------------
+            # CLICK文字列
+            # -------------------------
+            if rx_buf[0] == ord("C"):
+                if len(rx_buf) < 6:
+                    if b"CLICK\n".startswith(bytes(rx_buf)):
+                        return      # 続き待ち
+                    del rx_buf[0]
+                    continue
+                if rx_buf[:6] == b"CLICK\n":
+                    # クリック実行
+                    pydirectinput.click(button="left")
+                    del rx_buf[:6]
+                else:
+                    del rx_buf[0]
+                continue
+
+            # -------------------------
+            # 既存マウス移動パケット
+            # 0x30 dx dy
+            # -------------------------
+            if rx_buf[0] == 0x30:
+                if len(rx_buf) < 3:
+                    return
+                dx = int.from_bytes(bytes([rx_buf[1]]), "little", signed=True)
+                dy = int.from_bytes(bytes([rx_buf[2]]), "little", signed=True)
+                pydirectinput.moveRel(dx, dy, relative=True)
+                del rx_buf[:3]
+                continue
+
+            # -------------------------
+            # DEVICE_ID（HELLO への応答）
+            # -------------------------
+            if rx_buf[0] == DEV_MAGIC:
+                if len(rx_buf) < 2:
+                    return
+                if rx_buf[1] != DEV_CMD_DEVICE_ID:
+                    del rx_buf[0]
+                    continue
+                if len(rx_buf) < DEVICE_ID_LEN:
+                    return
+                self.sender.on_device_id(ser, bytes(rx_buf[:DEVICE_ID_LEN]))
+                del rx_buf[:DEVICE_ID_LEN]
+                continue
+
+            # 知らないバイトは捨てる
+            del rx_buf[0]
+
     def mouse_receiver_loop(self):
         rx_buf = bytearray()
+        last_ser = None
+
+        pydirectinput.PAUSE = 0
+        pydirectinput.FAILSAFE = False
 
         while True:
             ser = self.sender.ser
@@ -979,52 +1337,17 @@ class TypingMeterApp:
                 time.sleep(0.01)
                 continue
 
+            # ポートが変わったら前の途中データは捨てる
+            if ser is not last_ser:
+                rx_buf.clear()
+                last_ser = ser
+
             try:
                 n = ser.in_waiting
 
                 if n > 0:
                     rx_buf += ser.read(n)
-
-                # -------------------------
-                # CLICK文字列検出
-                # -------------------------
-                while b"CLICK\n" in rx_buf:
-                    pos = rx_buf.find(b"CLICK\n")
-
-                    # クリック実行
-                    pydirectinput.click(button="left")
-
-                    # 消す
-                    del rx_buf[pos:pos+6]
-
-                # -------------------------
-                # 既存マウス移動パケット
-                # 0x30 dx dy
-                # -------------------------
-                while len(rx_buf) >= 3:
-
-                    if rx_buf[0] != 0x30:
-                        del rx_buf[0]
-                        continue
-
-                    dx = int.from_bytes(
-                        bytes([rx_buf[1]]),
-                        "little",
-                        signed=True
-                    )
-
-                    dy = int.from_bytes(
-                        bytes([rx_buf[2]]),
-                        "little",
-                        signed=True
-                    )
-
-                    pydirectinput.moveRel(dx, dy, relative=True)
-
-                    del rx_buf[:3]
-
-                pydirectinput.PAUSE = 0
-                pydirectinput.FAILSAFE = False
+                    self._dispatch_rx(ser, rx_buf)
 
             except Exception:
                 pass
@@ -1156,6 +1479,9 @@ class TypingMeterApp:
         ttk.Label(stats_frame, text="Disk W").grid(row=4, column=0, sticky="w")
         ttk.Label(stats_frame, textvariable=self.disk_w_var).grid(row=4, column=1, sticky="w")
 
+        ttk.Label(stats_frame, text="Send").grid(row=5, column=0, sticky="w")
+        ttk.Label(stats_frame, textvariable=self.pcstats_tx_var).grid(row=5, column=1, sticky="w")
+
 
 
 
@@ -1388,11 +1714,8 @@ class TypingMeterApp:
         # ★ 成功した場合のみ保存
         save_last_port(link, port)
 
-        # マウス起動
-        threading.Thread(
-            target=self.mouse_receiver_loop,
-            daemon=True
-        ).start()
+        # 受信スレッド起動（再接続でも 1本だけ）
+        self.start_receiver()
 
         self.last_ports = load_last_ports()
 
@@ -1618,31 +1941,34 @@ class TypingMeterApp:
     def _tick(self):
         now = time.time()
 
-        # ---- PC Stats 更新（1秒に1回） ----
+        # ---- PC Stats 表示更新（1秒に1回。収集・送信は PCStatsWorker） ----
         if not hasattr(self, "_last_pcstats"):
             self._last_pcstats = 0
 
         if now - self._last_pcstats >= 1.0:
             self._last_pcstats = now
 
-            stats = self.pcstats.collect()
+            stats = self.pcstats.get_latest()
+            if stats is not None:
+                self.cpu_var.set(f"{stats['cpu']} %")
+                self.ram_var.set(f"{stats['ram']} %")
+                self.disk_var.set(f"{stats['disk']} %")
 
-            self.cpu_var.set(f"{stats['cpu_usage']} %")
-            self.ram_var.set(f"{stats['ram_usage']} %")
-            self.disk_var.set(f"{stats['disk_usage']} %")
+                # 🔽 Disk I/O
+                self.disk_r_var.set(f"{stats['disk_r']:.1f} MB/s")
+                self.disk_w_var.set(f"{stats['disk_w']:.1f} MB/s")
 
-            # 🔽 Disk I/O
-            r_mb, w_mb = self.disk_io.update()
-            self.disk_r_var.set(f"{r_mb:.1f} MB/s")
-            self.disk_w_var.set(f"{w_mb:.1f} MB/s")
-
-            if stats["cpu_temp"] is None:
-                self.temp_var.set("--")
-            else:
-                self.temp_var.set(f"{stats['cpu_temp']} °C")
+                if not stats["temps"]:
+                    self.temp_var.set("--")
+                else:
+                    self.temp_var.set(f"{int(stats['temps'][0])} °C")
 
-             # ★ Core2 へ送信
-            self.sender.send_pc_status(stats, r_mb, w_mb)
+            # 🔽 送信統計（ヒステリシスで間引いた項目数）
+            tx = self.pcstats.get_stats()
+            self.pcstats_tx_var.set(
+                f"{tx['frames']} frames / {tx['samples']} samples, "
+                f"fields {tx['sent']} sent / {tx['skipped']} skipped"
+            )
 
 
        # CPM ロジックを更新（QMK互換）
@@ -1693,6 +2019,7 @@ class TypingMeterApp:
             pass
 
         self.rawhid.stop()
+        self.pcstats.stop()
         self.sender.disconnect()
         self.root.destroy()
 
@@ -7,6 +7,7 @@
 #include <Preferences.h>
 
 #include <BluetoothSerial.h>
+#include <esp_timer.h>
 
 M5UnitGLASS2 glass;
 M5Canvas glassCanvas(&glass);
@@ -74,16 +75,17 @@ unsigned long lastCPMTime = 0;
 Preferences prefs;
 BluetoothSerial SerialBT;
 //Core2 起動時に自動接続
-void sendDeviceId() {
+// HELLO が来たポート（USB / BT）へそのまま返す
+void sendDeviceId(Stream& out = Serial) {
   uint8_t pkt[6] = {
     0x7F,  // magic
     0x01,  // DEVICE_ID
     0x01,  // protocol ver
     0x01,  // Core2
-    0x07,  // features
+    0x0F,  // features（0x08 = 拡張PCステータス TLV 対応）
     0x00
   };
-  Serial.write(pkt, sizeof(pkt));
+  out.write(pkt, sizeof(pkt));
 }
 
 void processHello() {
@@ -121,6 +123,34 @@ enum AppMode : uint8_t {
 volatile uint8_t activeSource = SRC_NONE;  // 現在の入力ソース
 AppMode          appMode      = MODE_I2C;  // デフォルトは I2C
 
+// ==== 入力ソース別状態（USB / BT / I2C のファンイン） ====
+// 複数のブリッジが同時に送ってきても針を取り合わないよう、ソースごとに
+// 最新 CPM・受信時刻・パケットレートを持ち、調停ポリシーで 1 つの値にまとめる
+enum ArbPolicy : uint8_t {
+    ARB_PRIORITY = 0,   // USB > BT > I2C の順で生きているソースを採用
+    ARB_MOST_RECENT,    // 最後に CPM を送ってきたソース
+    ARB_SUM,            // 生きているソースの CPM 合計（複数キーボード）
+    ARB_POLICY_COUNT
+};
+const char* const ARB_POLICY_NAMES[ARB_POLICY_COUNT] = { "PRIO", "RECENT", "SUM" };
+
+constexpr uint8_t       SRC_COUNT       = 4;     // SRC_NONE 含む
+constexpr unsigned long SOURCE_STALE_MS = 700;   // これ以上無通信なら調停対象外
+const uint8_t SOURCE_PRIORITY[] = { SRC_USB, SRC_BT, SRC_I2C };
+
+struct SourceState {
+    uint16_t      cpm;
+    unsigned long lastCpmMs;    // 0 = 未受信
+    uint16_t      packets;      // 現在の 1 秒窓のパケット数
+    uint16_t      packetRate;   // 直近 1 秒のパケット数
+};
+
+SourceState   sourceState[SRC_COUNT];
+ArbPolicy     arbPolicy          = ARB_MOST_RECENT;
+uint8_t       lastCpmSource      = SRC_NONE;
+unsigned long lastSourceRateMs   = 0;
+bool          sourceRatesDirty   = true;
+
 // ==== 定数 ====
 constexpr uint8_t I2C_SLAVE_ADDR = 0x0B;
 constexpr int CENTER_X = 160;
@@ -155,9 +185,27 @@ int historyCount = 0;   // ★ 実際に溜まったサンプル数
 static unsigned long lastKSUpdateMs = 0;
 
 // ==== Current CPM ====
-static uint16_t currentCPM = 0;
+static volatile uint16_t currentCPM = 0;
 // ==== Global 1-second tick ====
-static unsigned long lastTickMs = 0;
+// esp_timer が一定周期で currentCPM を標本化して tickQueue に積み、
+// loop() が取り出して onSecondTick() に渡す。loop が描画や delay で遅れても
+// 標本の時刻はずれず、取り出しが遅れるだけになる
+// 周期は 1 秒固定。onSecondTick() の打鍵数（cpm / 60）と 300 / 3600 標本の履歴は
+// 1 標本 = 1 秒が前提なので、ここだけ変えても履歴の時間軸は合わない
+constexpr uint64_t CPM_TICK_PERIOD_US = 1000000;
+constexpr uint8_t  TICK_QUEUE_SIZE    = 32;       // 2 のべき乗
+
+// タイマータスク（Core0）→ loop（Core1）の単一生産者・単一消費者リング（ロックなし）。
+// コアをまたぐので、中身の読み書きと head / tail の公開の間にバリアを入れる
+static uint16_t          tickQueue[TICK_QUEUE_SIZE];   // 標本化した CPM
+static volatile uint8_t  tickHead    = 0;   // タイマー側だけが書く
+static volatile uint8_t  tickTail    = 0;   // loop 側だけが書く
+static volatile uint32_t tickDropped = 0;   // キュー満杯で捨てた標本数
+static volatile uint32_t tickLate    = 0;   // 周期の半分以上遅れて発火した回数
+static esp_timer_handle_t tickTimer  = nullptr;
+static int64_t tickDueUs = 0;
+
+static unsigned long lastTickMs = 0;        // タイマーが使えない時のフォールバック
 static uint32_t totalSec = 0;   // ← TotalSec はこれだけで管理
 
 int chooseTimeStep(int totalSec) {
@@ -245,6 +293,28 @@ static unsigned long lastGlassUpdateMs = 0;
 constexpr unsigned long GLASS_RETICLE_UPDATE_MS = 63;  // 約15 FPS
 static unsigned long lastGlassReticleUpdateMs = 0;
 
+// ==== レティクルのフレームペーシング ====
+// マウス／スクロール／クリック直後は全速、その後徐々に減速して
+// ゆっくりした星空アニメへ。無入力・無打鍵が続いたら転送を止める
+enum GlassPaceState : uint8_t {
+    GLASS_PACE_ACTIVE = 0,  // 入力中：全速
+    GLASS_PACE_DECAY,       // 入力後：全速 → アイドルへ減速
+    GLASS_PACE_IDLE,        // 低速アニメ
+    GLASS_PACE_STATIC       // 静止：I2C 転送なし
+};
+const char GLASS_PACE_LABEL[] = { 'A', 'D', 'I', 'S' };
+
+constexpr unsigned long GLASS_PACE_HOLD_MS       = 1500;   // 入力後この間は全速
+constexpr unsigned long GLASS_PACE_DECAY_MS      = 5000;   // ここまでに減速しきる
+constexpr unsigned long GLASS_PACE_IDLE_FRAME_MS = 500;    // アイドル中の間隔
+constexpr unsigned long GLASS_PACE_STATIC_MS     = 60000;  // 無入力・無打鍵で静止
+
+static GlassPaceState glassPaceState       = GLASS_PACE_ACTIVE;
+static bool           glassReticleSettling = false;  // レティクルが目標へ移動中
+static uint16_t       glassReticleFrames   = 0;      // 今の 1 秒窓の転送数
+static uint16_t       glassReticleFps      = 0;      // 直近 1 秒の転送数（メトリクス）
+static unsigned long  glassFpsWindowMs     = 0;
+
 static uint8_t lastGlassCpu = 255;
 static uint8_t lastGlassRam = 255;
 static uint8_t lastGlassDisk = 255;
@@ -384,6 +454,39 @@ const uint16_t LAYER_ON_COLOR = TFT_CYAN;
 const uint16_t LAYER_OFF_COLOR = TFT_DARKGREY;
 int activeLayer = 0;  // 現在アクティブなレイヤー番号
 
+// 入力状況からペーシング状態と次フレームまでの間隔を決める（0 = 転送しない）
+unsigned long updateGlassPacing(unsigned long now) {
+    unsigned long lastInput = max(lastHudMouseMs, max(lastHudScrollMs, lastHudClickMs));
+    unsigned long quiet = now - lastInput;
+
+    bool pending = hudMouseDx != 0 || hudMouseDy != 0 || hudScrollDelta != 0;
+
+    if (pending || hudLockOnActive || glassReticleSettling ||
+        quiet < GLASS_PACE_HOLD_MS) {
+        glassPaceState = GLASS_PACE_ACTIVE;
+        return GLASS_RETICLE_UPDATE_MS;
+    }
+    if (quiet < GLASS_PACE_DECAY_MS) {
+        glassPaceState = GLASS_PACE_DECAY;
+        return GLASS_RETICLE_UPDATE_MS +
+            (GLASS_PACE_IDLE_FRAME_MS - GLASS_RETICLE_UPDATE_MS) *
+            (quiet - GLASS_PACE_HOLD_MS) / (GLASS_PACE_DECAY_MS - GLASS_PACE_HOLD_MS);
+    }
+    if (currentCPM > 0 || quiet < GLASS_PACE_STATIC_MS) {
+        glassPaceState = GLASS_PACE_IDLE;
+        return GLASS_PACE_IDLE_FRAME_MS;
+    }
+    glassPaceState = GLASS_PACE_STATIC;
+
+    // 転送が止まっている間も FPS メトリクスは 1 秒ごとに確定させる
+    if (now - glassFpsWindowMs >= 1000) {
+        glassReticleFps    = glassReticleFrames;
+        glassReticleFrames = 0;
+        glassFpsWindowMs   = now;
+    }
+    return 0;
+}
+
 // =====================================================
 // GLASS2 レティクル表示：追尾強化 + 手前→奥 星空
 // =====================================================
@@ -391,8 +494,23 @@ void drawGlassReticle() {
 
     unsigned long frameNow = millis();
 
-    // GLASS2の全面転送を約15FPSに制限
-    if (frameNow - lastGlassReticleUpdateMs < GLASS_RETICLE_UPDATE_MS) {
+    // 静止中でも表示内容（レイヤー・CPM・入力モード）が変われば 1 枚だけ描く
+    static int          drawnLayer = -1;
+    static uint16_t     drawnCpm   = 0;
+    static HudInputMode drawnMode  = HUD_INPUT_CURSOR;
+
+    unsigned long interval = updateGlassPacing(frameNow);
+
+    if (interval == 0) {
+        bool contentChanged = activeLayer  != drawnLayer ||
+                              currentCPM   != drawnCpm   ||
+                              hudInputMode != drawnMode;
+        if (!glassReticleFirstDraw && !contentChanged) {
+            return;
+        }
+    }
+    // GLASS2の全面転送をペーシング間隔に制限
+    else if (frameNow - lastGlassReticleUpdateMs < interval) {
         return;
     }
 
@@ -544,6 +662,11 @@ void drawGlassReticle() {
     reticleX += (targetX - reticleX) * FOLLOW * dt;
     reticleY += (targetY - reticleY) * FOLLOW * dt;
 
+    // 中央復帰・追尾が終わるまでは全速を維持
+    glassReticleSettling =
+        fabsf(targetX - reticleX) > 0.5f || fabsf(targetY - reticleY) > 0.5f ||
+        fabsf(targetX - BASE_X)   > 0.5f || fabsf(targetY - BASE_Y)   > 0.5f;
+
     int cx = round(reticleX);
     int cy = round(reticleY);
 
@@ -574,6 +697,11 @@ void drawGlassReticle() {
         glassCanvas.setTextColor(TFT_CYAN);
         glassCanvas.print("CSR");
     }
+
+    // ペーシング状態 + 転送FPS
+    glassCanvas.setTextColor(TFT_DARKGREY);
+    glassCanvas.setCursor(2, 44);
+    glassCanvas.printf("%c%d", GLASS_PACE_LABEL[glassPaceState], glassReticleFps);
     // -------------------------------------------------
     // 星空：手前 → 奥
     // 奥の消失点へ吸い込まれる
@@ -1029,6 +1157,18 @@ else {
     // 完成した1フレームを最後に一度だけ転送
     glassCanvas.pushSprite(0, 0);
 
+    drawnLayer = activeLayer;
+    drawnCpm   = currentCPM;
+    drawnMode  = hudInputMode;
+
+    // 転送FPS（1秒窓）
+    glassReticleFrames++;
+    if (now - glassFpsWindowMs >= 1000) {
+        glassReticleFps    = glassReticleFrames;
+        glassReticleFrames = 0;
+        glassFpsWindowMs   = now;
+    }
+
 }
 
 // ==== ⛽ ポモドーロ関連 ====
@@ -1112,12 +1252,73 @@ int last_disk_w_anim = -1;
 static uint8_t lastCmd = 0;
 float pc_disk_r_mbps = 0.0f;
 float pc_disk_w_mbps = 0.0f;
+
+// 拡張PCステータス（16bit 値、0.1 単位）
+constexpr uint8_t PC_EXT_MAX_CORES = 16;
+constexpr uint8_t PC_EXT_MAX_TEMPS = 8;
+
+struct PCStatusExt {
+    uint16_t cpu;      // 0.1%
+    uint16_t ram;      // 0.1%
+    uint16_t disk;     // 0.1%
+    uint16_t diskR;    // 0.1MB/s
+    uint16_t diskW;    // 0.1MB/s
+    uint16_t netRx;    // KB/s
+    uint16_t netTx;    // KB/s
+    uint16_t core[PC_EXT_MAX_CORES];   // 0.1%
+    uint8_t  coreCount;
+    int16_t  temp[PC_EXT_MAX_TEMPS];   // 0.1℃
+    uint8_t  tempCount;
+    uint8_t  version;  // 0 = 拡張フレーム未受信
+    unsigned long lastMs;   // 最後に正しいフレームを受けた時刻
+};
+
+// ブリッジは変化が無くても keepalive（既定 10 秒）ごとに全項目を送る。
+// その 2.5 倍届かなければ古い値として表示する
+constexpr unsigned long PC_EXT_STALE_MS = 25000;
+
+PCStatusExt pcExt = {};
+bool pcExtDirty = false;
+bool pcExtStaleShown = false;   // 画面に STALE を出しているか
 static float last_disk_r_mbps = -1.0f;
 static float last_disk_w_mbps = -1.0f;
 
-// ==== DEMO 用ダミー生成 ====
-unsigned long lastDemoTick = 0;
-int demoPhase = 0;
+// ==== DEMO シミュレーション（シード固定の負荷ジェネレータ） ====
+// 同じシードなら同じイベント列を再生する。プロファイルは一定時間ごとに巡回し、
+// 各プロファイル中の最悪フレーム時間 / ループ間隔を記録して Serial に出す。
+enum SimProfile : uint8_t {
+    SIM_CLASSIC = 0,     // 従来のサイン波デモ
+    SIM_BURST_TYPING,    // 2000CPM バースト打鍵
+    SIM_LAYER_THRASH,    // レイヤー高速切替
+    SIM_MOUSE_HUD,       // 100Hz マウス HUD デルタ
+    SIM_PCSTAT_FLOOD,    // PC ステータス飽和
+    SIM_PROFILE_COUNT
+};
+
+const char* const SIM_PROFILE_NAMES[SIM_PROFILE_COUNT] = {
+    "CLASSIC", "BURST", "LAYER", "MOUSE", "PCSTAT"
+};
+
+constexpr uint32_t SIM_SEED          = 0x5EED2000;
+constexpr uint32_t SIM_STEP_MS       = 10;     // 100Hz で生成
+constexpr uint32_t SIM_MAX_CATCHUP   = 10;     // 1ループで追いつく最大ステップ数
+constexpr uint32_t SIM_PROFILE_STEPS = 1500;   // 1プロファイル = 15秒
+
+struct SimStats {
+    uint32_t frames;
+    uint32_t frameMaxUs;   // loop 本体の最悪処理時間
+    uint32_t loopMaxUs;    // loop 呼び出し間隔の最悪値
+    uint64_t frameSumUs;
+    uint32_t events;       // 投入したイベント数
+    uint32_t logGraphMaxUs; // ログ折れ線描画の最悪時間
+};
+
+SimProfile simProfile   = SIM_CLASSIC;
+uint32_t simRng         = SIM_SEED;
+uint32_t simStep        = 0;      // プロファイル内ステップ
+unsigned long simNextMs = 0;
+SimStats simStats[SIM_PROFILE_COUNT];
+uint32_t simPrevLoopUs  = 0;      // 直前の loop 開始時刻（0 = 未計測）
 
 
 // ==== バイブレーション関数（ON時のみ動作） ====
@@ -1137,21 +1338,106 @@ uint16_t getScaleColor(int value) {
     }
     return meterColor;
 }
-uint16_t getCPMColor(int cpm) {
-    cpm = constrain(cpm, 0, VALUE_MAX);
-    uint8_t r = map(cpm, 0, VALUE_MAX, 0, 255);
-    uint8_t g = 0;
-    uint8_t b = map(cpm, 0, VALUE_MAX, 255, 0);
-    return M5.Display.color565(r, g, b);
+// ==== CPM → RGB565 パレット（青→赤） ====
+// 0〜VALUE_MAX の全値を起動時に一度だけ計算しておく
+static uint16_t cpmPalette[VALUE_MAX + 1];
+
+void buildCPMPalette() {
+    for (int cpm = 0; cpm <= VALUE_MAX; cpm++) {
+        uint8_t r = map(cpm, 0, VALUE_MAX, 0, 255);
+        uint8_t g = 0;
+        uint8_t b = map(cpm, 0, VALUE_MAX, 255, 0);
+        cpmPalette[cpm] = M5.Display.color565(r, g, b);
+    }
 }
 
-// ==== メーター背景描画 ====
-void drawMeterBackground() {
-    M5.Display.setTextDatum(TL_DATUM);
+inline uint16_t getCPMColor(int cpm) {
+    if (cpm < 0) cpm = 0;
+    else if (cpm > VALUE_MAX) cpm = VALUE_MAX;
+    return cpmPalette[cpm];
+}
+
+// ==== 折れ線のスパン描画 ====
+// 列 i には前列の y から今列の y までを縦線 1 本で塗る（drawLine を列ごとに呼ばない）。
+// ys はグラフ上端からの行、thick は線の太さ（下方向に足す）
+void drawCPMSpans(lgfx::LovyanGFX& g, int ox, int oy,
+                  const int16_t* ys, const uint16_t* cols, int n, int thick = 1) {
+    if (n <= 0) return;
+    int prev = ys[0];
+    for (int i = 0; i < n; i++) {
+        int y  = ys[i];
+        int y0 = min(prev, y);
+        int y1 = max(prev, y) + thick - 1;
+        g.drawFastVLine(ox + i, oy + y0, y1 - y0 + 1, cols[i]);
+        prev = y;
+    }
+}
+
+// ==== 背景スプライトキャッシュ ====
+// 画面ごとの静的な背景を meterColor 単位で PSRAM スプライトへ一度だけ描き、
+// 以降のモード切替・セーバー復帰は fillScreen せずに 1 回の転送で戻す。
+// 確保できなかった場合は従来通り画面へ直接描く。
+enum BgScreen : uint8_t { BG_METER = 0, BG_LOG, BG_PCSTAT, BG_PCSTAT_EXT, BG_COUNT };
+
+struct BgCacheSlot {
+    M5Canvas* canvas;
+    uint16_t  color;      // 描画時の meterColor
+    bool      allocated;
+    bool      failed;
+    bool      valid;
+};
+
+M5Canvas bgMeterCanvas(&M5.Display);
+M5Canvas bgLogCanvas(&M5.Display);
+M5Canvas bgPCStatCanvas(&M5.Display);
+M5Canvas bgPCStatExtCanvas(&M5.Display);
+
+BgCacheSlot bgCache[BG_COUNT] = {
+    { &bgMeterCanvas,  0, false, false, false },
+    { &bgLogCanvas,    0, false, false, false },
+    { &bgPCStatCanvas, 0, false, false, false },
+    { &bgPCStatExtCanvas, 0, false, false, false },
+};
+
+typedef void (*BgRasterFn)(lgfx::LovyanGFX& g);
+
+void pushCachedBackground(BgScreen id, BgRasterFn raster) {
+    BgCacheSlot& c = bgCache[id];
+
+    if (!c.allocated && !c.failed) {
+        c.canvas->setColorDepth(16);
+        c.canvas->setPsram(true);
+        if (c.canvas->createSprite(M5.Display.width(), M5.Display.height())) {
+            c.allocated = true;
+        } else {
+            c.failed = true;
+        }
+    }
+
+    if (c.failed) {
+        M5.Display.startWrite();
+        M5.Display.fillScreen(BLACK);
+        raster(M5.Display);
+        M5.Display.endWrite();
+        return;
+    }
+
+    // 色が変わった時だけ描き直す
+    if (!c.valid || c.color != meterColor) {
+        c.canvas->fillSprite(BLACK);
+        raster(*c.canvas);
+        c.color = meterColor;
+        c.valid = true;
+    }
+
     M5.Display.startWrite();
+    c.canvas->pushSprite(0, 0);
+    M5.Display.endWrite();
+}
 
-    M5.Display.fillScreen(BLACK);
-    
+// ==== メーター背景（ラスタライズ） ====
+void rasterMeterBackground(lgfx::LovyanGFX& g) {
+    g.setTextDatum(TL_DATUM);
 
     // 外周アーク（色スケール）
     for (int a = -120; a <= 120; a++) {
@@ -1159,7 +1445,7 @@ void drawMeterBackground() {
         polarToXY(a, RADIUS, px, py);
         int v = map(a, -120, 120, 0, VALUE_MAX);
         uint16_t col = getScaleColor(v);
-        M5.Display.drawPixel(px, py, col);
+        g.drawPixel(px, py, col);
     }
 
     // メモリ数字と補助線
@@ -1174,21 +1460,25 @@ void drawMeterBackground() {
 
         uint16_t c = getScaleColor(value);
 
-        M5.Display.setTextSize(2);
-        M5.Display.setTextColor(c);
-        M5.Display.setTextDatum(TL_DATUM);  // もう一度明示
-        M5.Display.setCursor(tx - 10, ty - 10);
-        M5.Display.drawLine(lx1, ly1, lx2, ly2, c);
+        g.setTextSize(2);
+        g.setTextColor(c);
+        g.setCursor(tx - 10, ty - 10);
+        g.drawLine(lx1, ly1, lx2, ly2, c);
 
         if (value == 1000) {
-            M5.Display.print("1K");
+            g.print("1K");
         } else {
-            M5.Display.printf("%d", value);
+            g.printf("%d", value);
         }
-        M5.Display.endWrite();
     }
 }
 
+// ==== メーター背景描画 ====
+void drawMeterBackground() {
+    pushCachedBackground(BG_METER, rasterMeterBackground);
+    M5.Display.setTextDatum(TL_DATUM);
+}
+
 void drawNeedle(int value, int oldValue) {
     // 古い針を消す
     int oldAngle = valueToAngle(oldValue);
@@ -1323,11 +1613,152 @@ void applyPCStatus(uint8_t cmd, uint8_t v) {
                 // ★ MB/s 実値（0.1MB/s 単位）
         case 0x25: pc_disk_r_mbps = v / 10.0f; break;
         case 0x26: pc_disk_w_mbps = v / 10.0f; break;
+        case 0x27: pcExt.temp[0] = v * 10; if (pcExt.tempCount == 0) pcExt.tempCount = 1; break;
     }
     // ここに追加
 
 }
 
+// ==== 拡張PCステータス（TLV）====
+// 0x40 [ver] [len] [TLV...] [sum8]
+//   TLV = [type] [bytes] [uint16 LE × n]
+//   sum8 = ver + len + TLV の 8bit 和
+// 同じ ver の中では未知の type を読み飛ばす。len は下の表で出せる最大長までしか受けない
+// （迷い込んだ 0x40 で後続の正規パケットを飲み込まないため）
+constexpr uint8_t PCX_HEADER  = 0x40;
+constexpr uint8_t PCX_VERSION = 0x01;   // ブリッジの PCX_VERSION と揃える
+
+static uint32_t pcxFrames    = 0;
+static uint32_t pcxBadFrames = 0;
+
+// type → 格納先。デコーダはこの表だけを見る
+struct PcxField {
+    void*    dest;        // uint16_t / int16_t の配列
+    uint8_t  maxCount;
+    uint8_t* count;       // 配列のみ（要素数）
+};
+
+constexpr PcxField PCX_FIELDS[] = {
+    /* 0x00 */ { nullptr,         0,                   nullptr },
+    /* 0x01 */ { &pcExt.cpu,      1,                   nullptr },
+    /* 0x02 */ { &pcExt.ram,      1,                   nullptr },
+    /* 0x03 */ { &pcExt.disk,     1,                   nullptr },
+    /* 0x04 */ { &pcExt.diskR,    1,                   nullptr },
+    /* 0x05 */ { &pcExt.diskW,    1,                   nullptr },
+    /* 0x06 */ { pcExt.core,      PC_EXT_MAX_CORES,    &pcExt.coreCount },
+    /* 0x07 */ { pcExt.temp,      PC_EXT_MAX_TEMPS,    &pcExt.tempCount },
+    /* 0x08 */ { &pcExt.netRx,    1,                   nullptr },
+    /* 0x09 */ { &pcExt.netTx,    1,                   nullptr },
+};
+constexpr uint8_t PCX_FIELD_COUNT = sizeof(PCX_FIELDS) / sizeof(PCX_FIELDS[0]);
+
+// 全項目を最大要素数で載せたときの TLV 長
+constexpr uint16_t pcxMaxPayload(uint8_t t = 0) {
+    return t >= PCX_FIELD_COUNT ? 0
+         : (PCX_FIELDS[t].dest ? 2 + PCX_FIELDS[t].maxCount * 2 : 0) + pcxMaxPayload(t + 1);
+}
+constexpr uint16_t PCX_MAX_PAYLOAD = pcxMaxPayload();
+static_assert(PCX_MAX_PAYLOAD <= 255, "PCX payload must fit the 1-byte len");
+
+struct PcxAssembler {
+    uint8_t state;     // 0: ver / 1: len / 2: payload / 3: checksum
+    uint8_t version;
+    uint8_t len;
+    uint8_t pos;
+    uint8_t sum;
+    uint8_t buf[PCX_MAX_PAYLOAD];
+};
+
+// ブリッジは変化した項目だけを送ってくる。載っていない項目は前回値のまま
+void applyPcxFrame(uint8_t version, const uint8_t* p, uint8_t len) {
+    bool changed = false;
+    uint16_t i = 0;
+    while (i + 2 <= len) {
+        uint8_t type  = p[i];
+        uint8_t bytes = p[i + 1];
+        if (i + 2 + bytes > len) {
+            pcxBadFrames++;
+            return;
+        }
+
+        if (type < PCX_FIELD_COUNT && PCX_FIELDS[type].dest != nullptr) {
+            const PcxField& f = PCX_FIELDS[type];
+            uint16_t* dest = static_cast<uint16_t*>(f.dest);
+            uint8_t n = min<uint8_t>(bytes / 2, f.maxCount);
+            for (uint8_t k = 0; k < n; k++) {
+                uint16_t v = p[i + 2 + k * 2] | (p[i + 3 + k * 2] << 8);
+                changed |= (dest[k] != v);
+                dest[k] = v;
+            }
+            if (f.count) {
+                changed |= (*f.count != n);
+                *f.count = n;
+            }
+        }
+        i += 2 + bytes;
+    }
+
+    changed |= (pcExt.version != version);
+    pcExt.version = version;
+    pcExt.lastMs  = millis();
+    pcxFrames++;
+    if (!changed) return;
+    pcExtDirty = true;
+
+    // 既存の 1byte 表示系へも反映（%・0.1MB/s へ丸める）
+    pc_cpu  = min(100, pcExt.cpu  / 10);
+    pc_ram  = min(100, pcExt.ram  / 10);
+    pc_disk = min(100, pcExt.disk / 10);
+    pc_disk_r_mbps  = pcExt.diskR / 10.0f;
+    pc_disk_w_mbps  = pcExt.diskW / 10.0f;
+    pc_disk_r_level = min(5, pcExt.diskR / 100);   // 10MB/s ごとに 1 段
+    pc_disk_W_level = min(5, pcExt.diskW / 100);
+}
+
+void pcxBegin(PcxAssembler& a) {
+    a.state = 0;
+}
+
+// 1 バイト投入。フレームが終わったら（成否に関わらず）true
+// ver / len が範囲外なら即座に打ち切り、呼び出し側は次のヘッダ待ちに戻る
+bool pcxFeed(PcxAssembler& a, uint8_t b) {
+    switch (a.state) {
+    case 0:
+        if (b != PCX_VERSION) {
+            pcxBadFrames++;
+            return true;
+        }
+        a.version = b;
+        a.sum = b;
+        a.state = 1;
+        return false;
+    case 1:
+        if (b > PCX_MAX_PAYLOAD) {
+            pcxBadFrames++;
+            a.state = 0;
+            return true;
+        }
+        a.len = b;
+        a.pos = 0;
+        a.sum += b;
+        a.state = (b == 0) ? 3 : 2;
+        return false;
+    case 2:
+        a.buf[a.pos++] = b;
+        a.sum += b;
+        if (a.pos >= a.len) a.state = 3;
+        return false;
+    default:
+        if (b == a.sum) {
+            applyPcxFrame(a.version, a.buf, a.len);
+        } else {
+            pcxBadFrames++;
+        }
+        a.state = 0;
+        return true;
+    }
+}
+
 void applyHudMouseMotion(int8_t dx, int8_t dy) {
 
     hudMouseDx += dx;
@@ -1376,21 +1807,142 @@ int getMovingAverageCPM() {
 return (countCPM > 0) ? (sumCPM / countCPM) : 0;
 }
 
-void onSecondTick() {
+// ==== PC ステータス履歴（1Hz × 10分、8bit 標本のリング） ====
+// CPU / RAM / DISK は 0〜100%、ディスク MB/s は受信と同じ 0.1MB/s 単位（0〜255）
+enum PCHistMetric : uint8_t {
+    PCH_CPU = 0,
+    PCH_RAM,
+    PCH_DISK,
+    PCH_DISK_R,
+    PCH_DISK_W,
+    PCH_COUNT
+};
+
+constexpr int PC_HIST_LEN = 600;   // 10分
+
+static uint8_t  pcHist[PCH_COUNT][PC_HIST_LEN];
+static uint16_t pcHistHead  = 0;   // 次に書く位置
+static uint16_t pcHistCount = 0;
+static uint32_t pcHistTotal = 0;   // 起動からの総標本数（バケット境界の基準）
+static uint32_t pcHistSum[PCH_COUNT];   // 窓内合計（平均用、差分更新）
+static bool     pcHistDirty = false;    // 新しい標本あり（描画側が落とす）
+
+uint8_t packMbps(float mbps) {
+    int v = (int)(mbps * 10.0f + 0.5f);
+    return (v < 0) ? 0 : (v > 255) ? 255 : v;
+}
+
+void pushPCStatSample() {
+    uint8_t sample[PCH_COUNT] = {
+        pc_cpu, pc_ram, pc_disk,
+        packMbps(pc_disk_r_mbps), packMbps(pc_disk_w_mbps)
+    };
+
+    for (int m = 0; m < PCH_COUNT; m++) {
+        if (pcHistCount == PC_HIST_LEN) {
+            pcHistSum[m] -= pcHist[m][pcHistHead];   // 押し出される標本
+        }
+        pcHist[m][pcHistHead] = sample[m];
+        pcHistSum[m] += sample[m];
+    }
+
+    pcHistHead = (pcHistHead + 1) % PC_HIST_LEN;
+    if (pcHistCount < PC_HIST_LEN) pcHistCount++;
+    pcHistTotal++;
+    pcHistDirty = true;
+}
+
+// 古い順で i 番目の標本
+inline uint8_t pcHistAt(int metric, int i) {
+    return pcHist[metric][(pcHistHead - pcHistCount + i + PC_HIST_LEN) % PC_HIST_LEN];
+}
+
+void getPCHistStats(int metric, uint8_t& mn, uint8_t& avg, uint8_t& mx) {
+    if (pcHistCount == 0) { mn = avg = mx = 0; return; }
+    mn = 255; mx = 0;
+    for (int i = 0; i < pcHistCount; i++) {
+        uint8_t v = pcHistAt(metric, i);
+        if (v < mn) mn = v;
+        if (v > mx) mx = v;
+    }
+    avg = pcHistSum[metric] / pcHistCount;
+}
+
+void onSecondTick(uint16_t cpm) {
     totalSec++;
 
+    // PC ステータス履歴
+    pushPCStatSample();
+
     // 打鍵数
-    totalKeystrokes += currentCPM / 60;
+    totalKeystrokes += cpm / 60;
 
     // === 直近用（300秒）===
-    pushCPMHistory(currentCPM);
+    pushCPMHistory(cpm);
 
     // === 全履歴用（最大3600秒）===
-    cpmLog[cpmLogIndex] = currentCPM;
+    cpmLog[cpmLogIndex] = cpm;
     cpmLogIndex = (cpmLogIndex + 1) % CPM_LOG_SIZE;
     if (cpmLogCount < CPM_LOG_SIZE) cpmLogCount++;
 }
 
+// esp_timer タスクから呼ばれる：標本を積むだけ
+void cpmTickTimerCb(void*) {
+    int64_t now = esp_timer_get_time();
+    if (now - tickDueUs > (int64_t)(CPM_TICK_PERIOD_US / 2)) {
+        tickLate++;
+    }
+    tickDueUs += CPM_TICK_PERIOD_US;
+
+    uint8_t head = tickHead;
+    uint8_t next = (head + 1) & (TICK_QUEUE_SIZE - 1);
+    if (next == tickTail) {
+        tickDropped++;
+        return;
+    }
+    tickQueue[head] = currentCPM;
+    __sync_synchronize();   // データを書いてから公開
+    tickHead = next;
+}
+
+void startCpmTickTimer() {
+    esp_timer_create_args_t args = {};
+    args.callback        = cpmTickTimerCb;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name            = "cpm_tick";
+
+    if (esp_timer_create(&args, &tickTimer) != ESP_OK) {
+        tickTimer = nullptr;
+        return;
+    }
+    tickDueUs = esp_timer_get_time() + CPM_TICK_PERIOD_US;
+    if (esp_timer_start_periodic(tickTimer, CPM_TICK_PERIOD_US) != ESP_OK) {
+        esp_timer_delete(tickTimer);   // 作ったハンドルは返してから millis() 方式へ
+        tickTimer = nullptr;
+    }
+}
+
+// loop から：溜まった標本を順に履歴へ
+void drainCpmTicks() {
+    if (tickTimer == nullptr) {
+        unsigned long now = millis();
+        if (now - lastTickMs >= CPM_TICK_PERIOD_US / 1000) {
+            lastTickMs += CPM_TICK_PERIOD_US / 1000;
+            onSecondTick(currentCPM);
+        }
+        return;
+    }
+
+    while (tickTail != tickHead) {
+        __sync_synchronize();   // head を見てから中身を読む
+        uint8_t tail = tickTail;
+        uint16_t cpm = tickQueue[tail];
+        __sync_synchronize();   // 読み終えてからスロットを返す
+        tickTail = (tail + 1) & (TICK_QUEUE_SIZE - 1);
+        onSecondTick(cpm);
+    }
+}
+
 
 void drawXAxisLabels(
     int baseX, int baseY,
@@ -1445,6 +1997,25 @@ void drawXAxisLabels(
 
 
 
+// ==== LOG グラフ用スプライト ====
+M5Canvas logGraphCanvas(&M5.Display);
+static uint32_t logGraphRenderUs = 0;   // 直近の折れ線描画時間（計測用）
+
+bool ensureLogGraphCanvas(int w, int h) {
+    static bool failed = false;
+    if (failed) return false;
+    if (logGraphCanvas.width() == w && logGraphCanvas.height() == h) return true;
+
+    logGraphCanvas.deleteSprite();
+    logGraphCanvas.setColorDepth(16);
+    logGraphCanvas.setPsram(true);
+    if (!logGraphCanvas.createSprite(w, h)) {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
 void drawCompressedLogGraph(
     int baseX, int baseY, int graphW, int graphH
 ) {
@@ -1468,22 +2039,12 @@ void drawCompressedLogGraph(
     // ==== 1px あたり何秒か ====
     float secPerPx = (float)totalSecLog / graphWpx;
 
-    // ==== 背景 ====
-    M5.Display.fillRect(
-        baseX, baseY - graphH,
-        graphW, graphH,
-        BLACK
-    );
-
-    // ==== Y軸 ====
-    M5.Display.drawLine(
-        graphStartX, baseY - graphH,
-        graphStartX, baseY,
-        TFT_DARKGREY
-    );
+    uint32_t renderStartUs = micros();
 
-    // ==== 圧縮描画（最大値方式）====
-    int prevY = -1;
+    // ==== 圧縮（最大値方式）→ 列ごとの y と色 ====
+    static int16_t  colY[GRAPH_WIDTH];
+    static uint16_t colC[GRAPH_WIDTH];
+    if (graphWpx > GRAPH_WIDTH) graphWpx = GRAPH_WIDTH;
 
     for (int px = 0; px < graphWpx; px++) {
 
@@ -1497,17 +2058,34 @@ void drawCompressedLogGraph(
             maxVal = max(maxVal, cpmLog[idx]);
         }
 
-        int y = baseY - map(maxVal, 0, valueRangeMax, 0, graphH);
-        int x = graphStartX + px;
+        colY[px] = graphH - map(maxVal, 0, valueRangeMax, 0, graphH);
+        colC[px] = getCPMColor(maxVal);
+    }
 
-        // ★ 折れ線化
-        if (prevY >= 0) {
-            M5.Display.drawLine(x - 1, prevY, x, y, getCPMColor(maxVal));
-        } else {
-            M5.Display.drawPixel(x, y, getCPMColor(maxVal));
-        }
+    // ==== 背景（目盛り側の余白） ====
+    M5.Display.fillRect(
+        baseX, baseY - graphH,
+        MARGIN_LEFT, graphH,
+        BLACK
+    );
+
+    // ==== グラフ本体：スプライトに Y軸＋折れ線を描いて一括転送 ====
+    if (ensureLogGraphCanvas(graphWpx, graphH + 1)) {
+        logGraphCanvas.fillSprite(BLACK);
+        logGraphCanvas.drawFastVLine(0, 0, graphH + 1, TFT_DARKGREY);
+        drawCPMSpans(logGraphCanvas, 0, 0, colY, colC, graphWpx);
+        logGraphCanvas.pushSprite(graphStartX, baseY - graphH);
+    } else {
+        M5.Display.fillRect(graphStartX, baseY - graphH, graphWpx, graphH, BLACK);
+        M5.Display.drawFastVLine(graphStartX, baseY - graphH, graphH + 1, TFT_DARKGREY);
+        drawCPMSpans(M5.Display, graphStartX, baseY - graphH, colY, colC, graphWpx);
+    }
 
-        prevY = y;
+    logGraphRenderUs = micros() - renderStartUs;
+    if (appMode == MODE_DEMO) {
+        // 描画ごとのログ出力はしない。[SIM] 定期サマリで報告する
+        SimStats& st = simStats[simProfile];
+        if (logGraphRenderUs > st.logGraphMaxUs) st.logGraphMaxUs = logGraphRenderUs;
     }
 
     // ==== Y軸目盛り ====
@@ -1601,17 +2179,16 @@ void updateGraphHistory(int cpm) {
         M5.Display.drawLine(baseX, y, baseX + graphW, y, TFT_DARKGREY);
     }
 
-    // 折れ線
-    int prevY = baseY - map(cpmGraph[0], 0, VALUE_MAX, 0, graphH);
-    for (int i = 1; i < GRAPH_WIDTH; i++) {
-        int x1 = baseX + i - 1;
-        int x2 = baseX + i;
-        int y2 = baseY - map(cpmGraph[i], 0, VALUE_MAX, 0, graphH);
-        uint16_t col = getCPMColor(cpmGraph[i]);
-        M5.Display.drawLine(x1, prevY, x2, y2, col);
-        M5.Display.drawLine(x1, prevY+1, x2, y2+1, col);
-        prevY = y2;
+    // 折れ線（太さ2のスパン描画）
+    static int16_t  colY[GRAPH_WIDTH];
+    static uint16_t colC[GRAPH_WIDTH];
+    for (int i = 0; i < GRAPH_WIDTH; i++) {
+        colY[i] = graphH - map(cpmGraph[i], 0, VALUE_MAX, 0, graphH);
+        colC[i] = getCPMColor(cpmGraph[i]);
     }
+    M5.Display.startWrite();
+    drawCPMSpans(M5.Display, baseX, baseY - graphH, colY, colC, GRAPH_WIDTH, 2);
+    M5.Display.endWrite();
 }
 
 // ==== 保存関数 ====
@@ -1658,11 +2235,22 @@ void saveLogSnapshot() {
 
 
 // ==== ログ画面 ====
+// ==== LOG 画面の静的部分（タイトルバー） ====
+void rasterLogBackground(lgfx::LovyanGFX& g) {
+    g.setTextDatum(MC_DATUM);
+    g.setTextColor(meterColor);
+    g.setTextSize(2);
+    g.drawString("LOG MODE", 240, 20);
+    g.drawLine(10, 40, 310, 40, TFT_DARKGREY);
+    g.setTextDatum(TL_DATUM);
+}
+
 void drawLogScreen() {
     // ★ LOGを開いた瞬間を記録点にする
     saveLogSnapshot();
     
-    M5.Display.fillScreen(BLACK);
+    // タイトルバー（キャッシュ背景）
+    pushCachedBackground(BG_LOG, rasterLogBackground);
      // ==== LOGモードの平均値を確定 ====
     logAvgCPM = getMovingAverageCPM();  // ←新しく作る関数
 
@@ -1671,13 +2259,6 @@ void drawLogScreen() {
     int w1 = GRAPH_WIDTH * 0.3;
     int w0 = GRAPH_WIDTH - w2 - w1;
 
-    // タイトルバー
-    M5.Display.setTextDatum(MC_DATUM);
-    M5.Display.setTextColor(meterColor);
-    M5.Display.setTextSize(2);
-    M5.Display.drawString("LOG MODE", 240, 20);
-    M5.Display.drawLine(10, 40, 310, 40, TFT_DARKGREY);
-
     // === 統計情報 ===
     int avgCPM = getMovingAverageCPM();  // リアルタイム平均（直近60サンプル）
     unsigned long elapsed = (millis() - startTime) / 1000;
@@ -1704,6 +2285,13 @@ void drawLogScreen() {
     M5.Display.setCursor(15, 122);
     M5.Display.printf("Uptime %02lu:%02lu:%02lu", elapsed/3600, (elapsed%3600)/60, elapsed%60);
 
+    // 1秒ティックの取りこぼし（キュー溢れ / 遅延発火）
+    M5.Display.setTextSize(1);
+    M5.Display.setTextColor(TFT_DARKGREY);
+    M5.Display.setCursor(15, 20);
+    M5.Display.printf("TICK drop:%lu late:%lu",
+                      (unsigned long)tickDropped, (unsigned long)tickLate);
+
     // ==== リプレイ開始 ====
     isReplaying = true;
     replayStartTime = millis();
@@ -1955,12 +2543,312 @@ void drawFloatValueText(int x, int y, float value) {
 }
 
 
-void drawPCStatusScreen() {
-    M5.Display.fillScreen(BLACK);
-    M5.Display.setTextColor(meterColor);
+// ==== PC STATUS 画面の静的部分（タイトル・ラベル・バー枠） ====
+void rasterPCStatusBackground(lgfx::LovyanGFX& g) {
+    g.setTextDatum(TL_DATUM);
+    g.setTextColor(meterColor);
+    g.setTextSize(2);
+    g.drawString("PC STATUS", 180, 10);
+    g.drawLine(10, 40, 310, 40, TFT_DARKGREY);
+
+    g.setTextColor(TFT_LIGHTGREY);
+    const char* labels[] = { "CPU:", "RAM:", "DISKu:", "DISKr:", "DISKw:" };
+    const int   rows[]   = { 60, 100, 140, 180, 200 };
+    for (int i = 0; i < 5; i++) {
+        g.drawString(labels[i], 18, rows[i]);
+    }
+    for (int i = 0; i < 3; i++) {
+        g.drawRect(90, rows[i], 170, 14, TFT_DARKGREY);
+    }
+}
+
+// ==== PC ステータスのスパークライン ====
+// 600 標本を 4 標本 / 1px（最大値）で 150px に圧縮。バケットが埋まるたびに
+// スプライトを 1px スクロールして右端の 1 列だけ描き足し、転送する
+constexpr int SPARK_W       = 150;
+constexpr int SPARK_H       = 18;
+constexpr int SPARK_X       = 90;
+constexpr int SPARK_BUCKET  = PC_HIST_LEN / SPARK_W;   // 4 秒 / px
+constexpr int SPARK_ROWS    = 3;                       // CPU / RAM / DISK（% と I/O）
+const int SPARK_ROW_Y[SPARK_ROWS] = { 60, 100, 140 }; // バーの行（その下に描く）
+
+M5Canvas sparkCanvas[SPARK_ROWS] = {
+    M5Canvas(&M5.Display), M5Canvas(&M5.Display), M5Canvas(&M5.Display)
+};
+static bool sparkReady  = false;
+static bool sparkFailed = false;
+static uint32_t sparkDrawnTotal = 0;   // 描画済みの総標本数
+
+uint16_t loadColor(int v) {
+    return (v >= 90) ? TFT_RED : (v >= 70) ? TFT_YELLOW : TFT_GREEN;
+}
+
+// 通し番号 absStart から始まるバケットの最大値（窓外の標本は無視）
+uint8_t sparkBucketMax(int metric, uint32_t absStart) {
+    uint32_t oldest = pcHistTotal - pcHistCount;
+    uint8_t mx = 0;
+    for (uint32_t a = absStart; a < absStart + SPARK_BUCKET && a < pcHistTotal; a++) {
+        if (a < oldest) continue;
+        uint8_t v = pcHistAt(metric, a - oldest);
+        if (v > mx) mx = v;
+    }
+    return mx;
+}
+
+// 1 列描画（スプライト座標）
+void drawSparkColumn(int row, int x, uint32_t absStart) {
+    M5Canvas& c = sparkCanvas[row];
+    c.drawFastVLine(x, 0, SPARK_H, BLACK);
+
+    // CPU / RAM / DISK 使用率（行番号 = 指標）
+    uint8_t v = sparkBucketMax(row, absStart);
+    int h = v * SPARK_H / 100;
+    if (h > 0) c.drawFastVLine(x, SPARK_H - h, h, loadColor(v));
+
+    if (row == PCH_DISK) {
+        // ディスク I/O：読み（水色）と書き（橙）を点で重ね、10MB/s でフルスケール
+        uint8_t r = sparkBucketMax(PCH_DISK_R, absStart);
+        uint8_t w = sparkBucketMax(PCH_DISK_W, absStart);
+        int hr = min(SPARK_H, r * SPARK_H / 100);
+        int hw = min(SPARK_H, w * SPARK_H / 100);
+        if (hr > 0) c.drawPixel(x, SPARK_H - hr, TFT_CYAN);
+        if (hw > 0) c.drawPixel(x, SPARK_H - hw, TFT_ORANGE);
+    }
+}
+
+bool ensureSparkCanvas() {
+    if (sparkReady)  return true;
+    if (sparkFailed) return false;
+    for (int r = 0; r < SPARK_ROWS; r++) {
+        sparkCanvas[r].setColorDepth(16);
+        if (!sparkCanvas[r].createSprite(SPARK_W, SPARK_H)) {
+            sparkFailed = true;
+            return false;
+        }
+    }
+    sparkReady = true;
+    return true;
+}
+
+// ディスク I/O の min/avg/max（DISKr / DISKw のバーの下。0.1MB/s 単位 → MB/s）
+void drawDiskIOStats(int metric, int y, uint16_t color) {
+    uint8_t mn, avg, mx;
+    char buf[32];
+    getPCHistStats(metric, mn, avg, mx);
+    snprintf(buf, sizeof(buf), "%.1f/%.1f/%.1f MB/s", mn / 10.0f, avg / 10.0f, mx / 10.0f);
+
+    M5.Display.fillRect(90, y, 170, 8, BLACK);
+    M5.Display.setTextDatum(TL_DATUM);
+    M5.Display.setTextSize(1);
+    M5.Display.setTextColor(color, BLACK);
+    M5.Display.drawString(buf, 90, y);
+}
+
+// min/avg/max（ラベル下、小文字）
+void drawSparkStats(int row) {
+    int y = SPARK_ROW_Y[row] + 20;
+    uint8_t mn, avg, mx;
+    char buf[16];
+
+    getPCHistStats(row, mn, avg, mx);
+    snprintf(buf, sizeof(buf), "%u/%u/%u", mn, avg, mx);
+
+    M5.Display.fillRect(18, y, 70, 8, BLACK);
+    M5.Display.setTextDatum(TL_DATUM);
+    M5.Display.setTextSize(1);
+    M5.Display.setTextColor(TFT_DARKGREY, BLACK);
+    M5.Display.drawString(buf, 18, y);
+
+    if (row == PCH_DISK) {
+        // 色はスパークラインの点と合わせる
+        drawDiskIOStats(PCH_DISK_R, 191, TFT_CYAN);
+        drawDiskIOStats(PCH_DISK_W, 211, TFT_ORANGE);
+    }
+}
+
+void pushSparkRow(int row) {
+    sparkCanvas[row].pushSprite(SPARK_X, SPARK_ROW_Y[row] + 17);
+}
+
+// 全列を描き直す（画面切替時）
+void drawPCSparklinesFull() {
+    pcHistDirty = false;
+    if (!ensureSparkCanvas()) return;
+    sparkDrawnTotal = pcHistTotal;
+
+    // 右端が最新バケット。バケット境界は通し番号の 4 の倍数
+    uint32_t oldest = pcHistTotal - pcHistCount;
+    for (int row = 0; row < SPARK_ROWS; row++) {
+        sparkCanvas[row].fillSprite(BLACK);
+        if (pcHistTotal > 0) {
+            uint32_t newest = (pcHistTotal - 1) / SPARK_BUCKET;
+            for (int x = SPARK_W - 1; x >= 0; x--) {
+                uint32_t k = SPARK_W - 1 - x;
+                if (k > newest) break;
+                uint32_t absStart = (newest - k) * SPARK_BUCKET;
+                if (absStart + SPARK_BUCKET <= oldest) break;
+                drawSparkColumn(row, x, absStart);
+            }
+        }
+        pushSparkRow(row);
+        drawSparkStats(row);
+    }
+}
+
+// 新しい標本 1 つ分の差分描画
+void updatePCSparklines() {
+    if (!pcHistDirty) return;
+    pcHistDirty = false;
+    if (!ensureSparkCanvas() || pcHistCount == 0) return;
+
+    // 複数標本まとめて来た（loop が詰まった）時は全体を描き直す
+    if (pcHistTotal - sparkDrawnTotal != 1) {
+        drawPCSparklinesFull();
+        return;
+    }
+    sparkDrawnTotal = pcHistTotal;
+
+    // 最新バケットの先頭標本（通し番号）
+    uint32_t newest   = pcHistTotal - 1;
+    uint32_t inBucket = newest % SPARK_BUCKET;
+    bool newBucket    = (inBucket == 0);
+
+    for (int row = 0; row < SPARK_ROWS; row++) {
+        if (newBucket) {
+            sparkCanvas[row].scroll(-1, 0);
+        }
+        drawSparkColumn(row, SPARK_W - 1, newest - inBucket);
+        pushSparkRow(row);
+        drawSparkStats(row);
+    }
+}
+
+// ==== PC STATUS 2ページ目（コア別CPU・温度・ネットワーク） ====
+// タイトル帯タップでページ切替
+static uint8_t pcStatPage = 0;
+constexpr uint8_t PC_STAT_PAGES = 2;
+
+constexpr int CORE_BAR_X   = 18;
+constexpr int CORE_BAR_Y   = 52;    // 上端
+constexpr int CORE_BAR_H   = 80;
+constexpr int CORE_BAR_W   = 14;
+constexpr int CORE_BAR_GAP = 4;
+
+static int16_t lastCoreH[PC_EXT_MAX_CORES];
+
+void rasterPCStatusExtBackground(lgfx::LovyanGFX& g) {
+    g.setTextDatum(TL_DATUM);
+    g.setTextColor(meterColor);
+    g.setTextSize(2);
+    g.drawString("PC CORES", 180, 10);
+    g.drawLine(10, 40, 310, 40, TFT_DARKGREY);
+
+    g.setTextColor(TFT_LIGHTGREY);
+    g.drawString("TEMP:", 18, 156);
+    g.drawString("NET:",  18, 186);
+}
+
+void drawCoreBar(int i, bool force) {
+    int h = (i < pcExt.coreCount)
+        ? min<int>(CORE_BAR_H, pcExt.core[i] * CORE_BAR_H / 1000)
+        : -1;
+    if (!force && h == lastCoreH[i]) return;
+    lastCoreH[i] = h;
+
+    int x = CORE_BAR_X + i * (CORE_BAR_W + CORE_BAR_GAP);
+    M5.Display.fillRect(x, CORE_BAR_Y, CORE_BAR_W, CORE_BAR_H, BLACK);
+    if (h < 0) return;
+
+    M5.Display.drawRect(x, CORE_BAR_Y, CORE_BAR_W, CORE_BAR_H, TFT_DARKGREY);
+    if (h > 0) {
+        M5.Display.fillRect(x + 1, CORE_BAR_Y + CORE_BAR_H - h, CORE_BAR_W - 2, h,
+                            loadColor(pcExt.core[i] / 10));
+    }
+}
+
+bool pcExtIsStale() {
+    return pcExt.version != 0 && millis() - pcExt.lastMs > PC_EXT_STALE_MS;
+}
+
+void drawPCStatusExtValues(bool force) {
+    for (int i = 0; i < PC_EXT_MAX_CORES; i++) {
+        drawCoreBar(i, force);
+    }
+
+    char buf[48];
+    M5.Display.setTextDatum(TL_DATUM);
+    M5.Display.setTextSize(1);
+
+    // コア番号 / 受信状態
+    M5.Display.fillRect(18, 136, 300, 10, BLACK);
+    M5.Display.setTextColor(TFT_DARKGREY, BLACK);
+    pcExtStaleShown = pcExtIsStale();
+    if (pcExt.version == 0) {
+        M5.Display.drawString("no extended frame (bridge v1)", 18, 136);
+    } else {
+        if (pcExtStaleShown) M5.Display.setTextColor(TFT_ORANGE, BLACK);
+        snprintf(buf, sizeof(buf), "%u cores  v%u  ok:%lu bad:%lu%s",
+                 pcExt.coreCount, pcExt.version,
+                 (unsigned long)pcxFrames, (unsigned long)pcxBadFrames,
+                 pcExtStaleShown ? "  STALE" : "");
+        M5.Display.drawString(buf, 18, 136);
+    }
+
+    // 温度（最大4つ）
+    M5.Display.fillRect(90, 156, 230, 16, BLACK);
     M5.Display.setTextSize(2);
-    M5.Display.drawString("PC STATUS", 180, 10);
-    M5.Display.drawLine(10, 40, 310, 40, TFT_DARKGREY);
+    M5.Display.setTextColor(meterColor, BLACK);
+    int x = 90;
+    for (int i = 0; i < pcExt.tempCount && i < 4; i++) {
+        snprintf(buf, sizeof(buf), "%d", pcExt.temp[i] / 10);
+        M5.Display.setTextColor(pcExt.temp[i] >= 800 ? TFT_RED : meterColor, BLACK);
+        M5.Display.drawString(buf, x, 156);
+        x += 54;
+    }
+
+    // ネットワーク
+    M5.Display.fillRect(90, 186, 230, 16, BLACK);
+    M5.Display.setTextColor(meterColor, BLACK);
+    snprintf(buf, sizeof(buf), "%5u/%5uK", pcExt.netRx, pcExt.netTx);
+    M5.Display.drawString(buf, 90, 186);
+
+    pcExtDirty = false;
+}
+
+void drawPCStatusExtScreen() {
+    pushCachedBackground(BG_PCSTAT_EXT, rasterPCStatusExtBackground);
+    drawPCStatusExtValues(true);
+}
+
+void updatePCStatusExtScreen() {
+    if (pcExtDirty || pcExtIsStale() != pcExtStaleShown) drawPCStatusExtValues(false);
+}
+
+// ==== ソース別パケットレート（PC STATUS 最下段） ====
+void drawSourceRates() {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "USB %3u/s  BT %3u/s  I2C %3u/s  [%s]",
+             sourceState[SRC_USB].packetRate,
+             sourceState[SRC_BT].packetRate,
+             sourceState[SRC_I2C].packetRate,
+             ARB_POLICY_NAMES[arbPolicy]);
+
+    M5.Display.fillRect(0, 222, 320, 12, BLACK);
+    M5.Display.setTextDatum(TL_DATUM);
+    M5.Display.setTextSize(1);
+    M5.Display.setTextColor(TFT_LIGHTGREY, BLACK);
+    M5.Display.drawString(buf, 18, 224);
+    sourceRatesDirty = false;
+}
+
+void drawPCStatusScreen() {
+    if (pcStatPage == 1) {
+        drawPCStatusExtScreen();
+        drawSourceRates();
+        return;
+    }
+
+    pushCachedBackground(BG_PCSTAT, rasterPCStatusBackground);
 
     drawBar("CPU:",    pc_cpu,   60);
     drawValueText(260, 60, pc_cpu, "%", true);
@@ -1983,6 +2871,9 @@ void drawPCStatusScreen() {
     last_disk   = pc_disk;
     last_disk_r = pc_disk_r_level;
     last_disk_w = pc_disk_W_level;
+
+    drawPCSparklinesFull();
+    drawSourceRates();
 }
 
 
@@ -2089,34 +2980,66 @@ const int shiftY = 30;
 // ギア文字描画
 const char* shiftLabel[] = { "0", "1", "2", "3", "R" };
 
+// ==== シフトインジケータ用スプライト ====
+// ギア文字は (meterColor, targetShift) が変わった時だけ shiftBg に描き直し、
+// アニメ中は shiftBg → shiftCanvas へコピーしてノブだけ重ねて転送する
+const int SHIFT_AREA_X = 210;
+const int SHIFT_AREA_W = 120;
+const int SHIFT_AREA_H = 50;
+
+M5Canvas shiftBg(&M5.Display);
+M5Canvas shiftCanvas(&M5.Display);
+static bool      shiftSpritesReady = false;
+static uint16_t  shiftBgColor      = 0;
+static int       shiftBgTarget     = -1;
+
+bool ensureShiftSprites() {
+    if (!shiftSpritesReady) {
+        shiftBg.setColorDepth(16);
+        shiftCanvas.setColorDepth(16);
+        if (!shiftBg.createSprite(SHIFT_AREA_W, SHIFT_AREA_H) ||
+            !shiftCanvas.createSprite(SHIFT_AREA_W, SHIFT_AREA_H)) {
+            shiftBg.deleteSprite();
+            shiftCanvas.deleteSprite();
+            return false;
+        }
+        shiftSpritesReady = true;
+    }
+
+    // 色 or 選択ギアが変わった時だけ文字を描き直す
+    if (shiftBgTarget != targetShift || shiftBgColor != meterColor) {
+        shiftBg.fillSprite(BLACK);
+        shiftBg.setTextSize(2);
+        for (int i = 0; i < 5; i++) {
+            uint16_t color = (i == targetShift) ? meterColor : TFT_DARKGREY;
+            shiftBg.setTextColor(color, BLACK);
+            shiftBg.setCursor(shiftX[i] - 5 - SHIFT_AREA_X, shiftY - 25);
+            shiftBg.print(shiftLabel[i]);
+        }
+        shiftBgTarget = targetShift;
+        shiftBgColor  = meterColor;
+    }
+    return true;
+}
+
+// 文字レイヤ + ノブを合成して 1 回で転送
+void pushShiftLayer(int knobX) {
+    if (!ensureShiftSprites()) return;
+    shiftBg.pushSprite(&shiftCanvas, 0, 0);
+    shiftCanvas.fillCircle(knobX - SHIFT_AREA_X, shiftY, 5, meterColor);
+    shiftCanvas.pushSprite(SHIFT_AREA_X, 0);
+}
+
 // ==== シフトインジケータ描画 ====
 void drawShiftIndicator_light() {
-    static ShiftMode lastDrawnShift = SHIFT_P;
-    static int lastKnobX = -1;
-
     // アニメーション進行
     float t = min(1.0f, (millis() - lastShiftAnim) / (float)SHIFT_ANIM_DURATION);
     int fromX = shiftX[currentShift];
     int toX   = shiftX[targetShift];
     int knobX = fromX + (toX - fromX) * t;
-    
-        // 背景部分のみクリア
-        M5.Display.fillRect(210, 0, 120, 50, BLACK);
 
-        // 各ギア文字
-        for (int i = 0; i < 5; i++) {
-            uint16_t color = (i == targetShift) ? meterColor : TFT_DARKGREY;
-            M5.Display.setTextSize(2);
-            M5.Display.setTextColor(color, BLACK);
-            M5.Display.setCursor(shiftX[i] - 5, shiftY - 25);
-            M5.Display.print(shiftLabel[i]);
-        }
-
-        // ノブ描画
-        M5.Display.fillCircle(knobX, shiftY, 5, meterColor);
-        //M5.Display.drawCircle(knobX, shiftY, 9, TFT_WHITE);
-
-    }
+    pushShiftLayer(knobX);
+}
 
 void drawShiftIndicator() {
     static ShiftMode lastDrawnShift = SHIFT_P;
@@ -2131,21 +3054,7 @@ void drawShiftIndicator() {
 
     // ノブが移動した or シフトが変わったときだけ再描画
     if (knobX != lastKnobX || currentShift != lastDrawnShift) {
-        // 背景部分のみクリア
-        M5.Display.fillRect(210, 0, 120, 50, BLACK);
-
-        // 各ギア文字
-        for (int i = 0; i < 5; i++) {
-            uint16_t color = (i == targetShift) ? meterColor : TFT_DARKGREY;
-            M5.Display.setTextSize(2);
-            M5.Display.setTextColor(color, BLACK);
-            M5.Display.setCursor(shiftX[i] - 5, shiftY - 25);
-            M5.Display.print(shiftLabel[i]);
-        }
-
-        // ノブ描画
-        M5.Display.fillCircle(knobX, shiftY, 5, meterColor);
-        //M5.Display.drawCircle(knobX, shiftY, 9, TFT_WHITE);
+        pushShiftLayer(knobX);
 
         lastKnobX = knobX;
         lastDrawnShift = currentShift;
@@ -2195,6 +3104,78 @@ void applyLayer(uint8_t layer) {
                    (appMode == MODE_DEMO) ? SRC_NONE : SRC_NONE;
 }
 
+// ==== 入力ソース調停 ====
+bool isSourceLive(uint8_t src, unsigned long now) {
+    const SourceState& st = sourceState[src];
+    return st.lastCpmMs != 0 && now - st.lastCpmMs <= SOURCE_STALE_MS;
+}
+
+void countSourcePacket(uint8_t src) {
+    if (src < SRC_COUNT) sourceState[src].packets++;
+}
+
+// 現在のポリシーで針を受け持つソース
+uint8_t arbitrationOwner(unsigned long now) {
+    if (arbPolicy == ARB_PRIORITY) {
+        for (uint8_t src : SOURCE_PRIORITY) {
+            if (isSourceLive(src, now)) return src;
+        }
+    }
+    return lastCpmSource;
+}
+
+// 各トランスポートの CPM はここを通してから applyCPM へ
+void onSourceCPM(uint8_t src, uint16_t cpm) {
+    unsigned long now = millis();
+    sourceState[src].cpm       = cpm;
+    sourceState[src].lastCpmMs = now;
+    lastCpmSource = src;
+
+    uint8_t  owner = arbitrationOwner(now);
+    uint16_t value = sourceState[owner].cpm;
+
+    if (arbPolicy == ARB_SUM) {
+        uint32_t sum = 0;
+        for (uint8_t s : SOURCE_PRIORITY) {
+            if (isSourceLive(s, now)) sum += sourceState[s].cpm;
+        }
+        value = (sum > VALUE_MAX) ? VALUE_MAX : sum;
+    }
+
+    applyCPM(value);
+    activeSource = owner;
+}
+
+// PRIORITY では針を持っていないソースのレイヤー変更は無視
+void onSourceLayer(uint8_t src, uint8_t layer) {
+    unsigned long now = millis();
+    uint8_t owner = arbitrationOwner(now);
+    if (arbPolicy == ARB_PRIORITY && owner != src && isSourceLive(owner, now)) return;
+
+    applyLayer(layer);
+    activeSource = src;
+}
+
+// 1 秒窓でパケット数を確定
+void updateSourceRates() {
+    unsigned long now = millis();
+    if (now - lastSourceRateMs < 1000) return;
+    lastSourceRateMs = now;
+
+    for (uint8_t i = 0; i < SRC_COUNT; i++) {
+        uint16_t rate = sourceState[i].packets;
+        sourceState[i].packets = 0;
+        if (rate != sourceState[i].packetRate) sourceRatesDirty = true;
+        sourceState[i].packetRate = rate;
+    }
+}
+
+void cycleArbPolicy() {
+    arbPolicy = (ArbPolicy)((arbPolicy + 1) % ARB_POLICY_COUNT);
+    prefs.putUChar("arbPolicy", arbPolicy);
+    sourceRatesDirty = true;
+}
+
 // ==== Fuel表示用：現在の燃料％を返す ====
 // Pomodoro中 → タイマー燃料
 // それ以外 → バッテリー残量
@@ -2213,68 +3194,158 @@ int getFuelPercent() {
     return batteryPct;
 }
 
-// ==== 小型ガソリンメーター描画（右下E・左上F配置・針反転＋モード別数値ラベル） ====
-void drawFuelMeter(int level) {
-    int cx = 45;     // 中心X
-    int cy = 230;    // 中心Y
-    int r = 46 ;      // 半径
-    const int ANGLE_OFFSET = 15;  
-    const int START_ANGLE = -140 + ANGLE_OFFSET-6;  // F位置（左上）
-    const int END_ANGLE   = -40 + ANGLE_OFFSET-20;   // E位置（右下）
-    const int SWEEP = END_ANGLE - START_ANGLE;
-    const int RED_ZONE_PERCENT = 25;   // 残量15%以下を赤エリアに設定
-    const int RED_ZONE_ANGLE   = (SWEEP * RED_ZONE_PERCENT) / 100; // 約15°相当
-
-    // --- 背景 ---
-    M5.Display.fillRect(cx - r - 6, cy - r - 6, r * 2 + 12, r * 2 + 12, BLACK);
-
-    // --- 外円弧 ---
-    for (int i = 0; i <= SWEEP; i++) {
-        int a = START_ANGLE + i;
-        // E側15%分をレッドゾーン
-        uint16_t col = (i < RED_ZONE_ANGLE) ? TFT_RED : meterColor;
-        int x = cx + cos(a * PI / 180.0) * r;
-        int y = cy + sin(a * PI / 180.0) * r;
-        M5.Display.drawPixel(x, y, col);
-    }
-
-// --- メモリ線 ---
-const int tickCount = 4;  // 0%, 25%, 50%, 75%, 100%
-for (int i = 0; i <= tickCount; i++) {
-    int val = i * 25;
-    int a = END_ANGLE - (val * (SWEEP) / 100);
-
-    // 🔴 E側2本分（0%と25%）をレッドゾーン化
-    uint16_t col = (i >= tickCount - 1) ? TFT_RED :  meterColor;
-
-    int x1 = cx + cos(a * PI / 180.0) * (r - 5);
-    int y1 = cy + sin(a * PI / 180.0) * (r - 5);
-    int x2 = cx + cos(a * PI / 180.0) * (r + 1);
-    int y2 = cy + sin(a * PI / 180.0) * (r + 1);
-    M5.Display.drawLine(x1, y1, x2, y2, col);
-}
-    // --- 針（反時計回り F→E）---
+// ==== 小型ガソリンメーター（スプライトキャッシュ） ====
+// 目盛り・円弧・E/F は meterColor ごとに fuelDialBg へ一度だけ描く。
+// 角度は整数度なので cos/sin は START〜END の LUT から引く。
+// 針の更新は fuelDialBg → fuelCanvas に複写して針を描き、
+// 旧針と新針を囲む矩形だけをクリップして転送する。
+const int FUEL_CX = 45;     // 中心X
+const int FUEL_CY = 230;    // 中心Y
+const int FUEL_R  = 46;     // 半径
+const int FUEL_ANGLE_OFFSET = 15;
+const int FUEL_START_ANGLE  = -140 + FUEL_ANGLE_OFFSET - 6;  // F位置（左上）
+const int FUEL_END_ANGLE    = -40 + FUEL_ANGLE_OFFSET - 20;  // E位置（右下）
+const int FUEL_SWEEP        = FUEL_END_ANGLE - FUEL_START_ANGLE;
+const int FUEL_RED_ZONE_PERCENT = 25;   // 残量25%以下を赤エリアに設定
+const int FUEL_RED_ZONE_ANGLE   = (FUEL_SWEEP * FUEL_RED_ZONE_PERCENT) / 100;
+const int FUEL_NEEDLE_LEN       = FUEL_R - 10;
+
+// 画面上のスプライト領域（画面外にはみ出す下側は持たない）
+const int FUEL_AREA_X = FUEL_CX - FUEL_R - 6;
+const int FUEL_AREA_Y = FUEL_CY - FUEL_R - 6;
+const int FUEL_AREA_W = FUEL_R * 2 + 12;
+const int FUEL_AREA_H = 240 - FUEL_AREA_Y;
+
+static float fuelCosLut[FUEL_SWEEP + 1];
+static float fuelSinLut[FUEL_SWEEP + 1];
+static int8_t fuelTipDx[101];   // 残量 0〜100 の針先オフセット
+static int8_t fuelTipDy[101];
+static bool fuelLutReady = false;
+
+M5Canvas fuelDialBg(&M5.Display);
+M5Canvas fuelCanvas(&M5.Display);
+static bool     fuelSpritesReady = false;
+static bool     fuelDialValid    = false;
+static uint16_t fuelDialColor    = 0;
+static int      fuelShownLevel   = -1;   // 画面上の針位置（-1 = 未描画）
+
+void buildFuelLut() {
+    if (fuelLutReady) return;
+    for (int i = 0; i <= FUEL_SWEEP; i++) {
+        float rad = (FUEL_START_ANGLE + i) * (float)PI / 180.0f;
+        fuelCosLut[i] = cosf(rad);
+        fuelSinLut[i] = sinf(rad);
+    }
     // F=100, E=0 → 値が小さくなるほど右へ回る
-    int a = END_ANGLE - ((100 - level) * SWEEP / 100);
-    int nx = cx + cos(a * PI / 180.0) * (r - 10);
-    int ny = cy + sin(a * PI / 180.0) * (r - 10);
-    M5.Display.drawLine(cx, cy, nx, ny, TFT_RED);
-    M5.Display.fillCircle(cx, cy, 3, TFT_RED);
+    for (int level = 0; level <= 100; level++) {
+        int idx = FUEL_SWEEP - ((100 - level) * FUEL_SWEEP / 100);
+        fuelTipDx[level] = (int8_t)(fuelCosLut[idx] * FUEL_NEEDLE_LEN);
+        fuelTipDy[level] = (int8_t)(fuelSinLut[idx] * FUEL_NEEDLE_LEN);
+    }
+    fuelLutReady = true;
+}
+
+// 円弧上の点（スプライト座標）
+inline int fuelPX(int idx, int r) { return FUEL_CX - FUEL_AREA_X + (int)(fuelCosLut[idx] * r); }
+inline int fuelPY(int idx, int r) { return FUEL_CY - FUEL_AREA_Y + (int)(fuelSinLut[idx] * r); }
+
+// 文字盤（針以外）を meterColor で描き直す
+bool ensureFuelDial() {
+    buildFuelLut();
+
+    if (!fuelSpritesReady) {
+        fuelDialBg.setColorDepth(16);
+        fuelCanvas.setColorDepth(16);
+        if (!fuelDialBg.createSprite(FUEL_AREA_W, FUEL_AREA_H) ||
+            !fuelCanvas.createSprite(FUEL_AREA_W, FUEL_AREA_H)) {
+            fuelDialBg.deleteSprite();
+            fuelCanvas.deleteSprite();
+            return false;
+        }
+        fuelSpritesReady = true;
+    }
+    if (fuelDialValid && fuelDialColor == meterColor) return true;
+
+    fuelDialBg.fillSprite(BLACK);
+
+    // --- 外円弧（E側25%分をレッドゾーン）---
+    for (int i = 0; i <= FUEL_SWEEP; i++) {
+        uint16_t col = (i < FUEL_RED_ZONE_ANGLE) ? TFT_RED : meterColor;
+        fuelDialBg.drawPixel(fuelPX(i, FUEL_R), fuelPY(i, FUEL_R), col);
+    }
+
+    // --- メモリ線 0%, 25%, 50%, 75%, 100% ---
+    const int tickCount = 4;
+    for (int i = 0; i <= tickCount; i++) {
+        int val = i * 25;
+        int idx = FUEL_SWEEP - (val * FUEL_SWEEP / 100);
+        // 🔴 E側2本分（0%と25%）をレッドゾーン化
+        uint16_t col = (i >= tickCount - 1) ? TFT_RED : meterColor;
+        fuelDialBg.drawLine(fuelPX(idx, FUEL_R - 5), fuelPY(idx, FUEL_R - 5),
+                            fuelPX(idx, FUEL_R + 1), fuelPY(idx, FUEL_R + 1), col);
+    }
 
     // --- E / F ラベル ---
-    int fX = cx + cos(START_ANGLE * PI / 180.0) * (r + 10);
-    int fY = cy + sin(START_ANGLE * PI / 180.0) * (r + 10);
-    int eX = cx + cos(END_ANGLE * PI / 180.0) * (r + 10);
-    int eY = cy + sin(END_ANGLE * PI / 180.0) * (r + 10);
+    int fX = fuelPX(0, FUEL_R + 10);
+    int fY = fuelPY(0, FUEL_R + 10);
+    int eX = fuelPX(FUEL_SWEEP, FUEL_R + 10);
+    int eY = fuelPY(FUEL_SWEEP, FUEL_R + 10);
+
+    fuelDialBg.setTextSize(1);
+    fuelDialBg.setTextColor(TFT_RED, BLACK);
+    fuelDialBg.setCursor(fX + 4, fY + 18);
+    fuelDialBg.print("E");
+    fuelDialBg.setTextColor(meterColor, BLACK);
+    fuelDialBg.setCursor(eX - 7, eY + 16);
+    fuelDialBg.print("F");
+
+    fuelDialColor = meterColor;
+    fuelDialValid = true;
+    return true;
+}
 
-    M5.Display.setTextSize(1);
-    M5.Display.setTextColor(TFT_RED, BLACK);
-    M5.Display.setCursor(fX + 4, fY +18);
-    M5.Display.print("E");
-    M5.Display.setTextColor(meterColor, BLACK);
-    M5.Display.setCursor(eX - 7, eY +16);
-    M5.Display.print("F");
+// 文字盤を複写して針を重ねる
+void composeFuelCanvas(int level) {
+    int cx = FUEL_CX - FUEL_AREA_X;
+    int cy = FUEL_CY - FUEL_AREA_Y;
+    fuelDialBg.pushSprite(&fuelCanvas, 0, 0);
+    fuelCanvas.drawLine(cx, cy, cx + fuelTipDx[level], cy + fuelTipDy[level], TFT_RED);
+    fuelCanvas.fillCircle(cx, cy, 3, TFT_RED);
+}
 
+// ==== 小型ガソリンメーター描画（右下E・左上F配置・針反転＋モード別数値ラベル） ====
+// 全面転送。画面を消した後や色変更後はこちらを使う
+void drawFuelMeter(int level) {
+    level = constrain(level, 0, 100);
+    if (!ensureFuelDial()) return;
+
+    composeFuelCanvas(level);
+    fuelCanvas.pushSprite(FUEL_AREA_X, FUEL_AREA_Y);
+    fuelShownLevel = level;
+}
+
+// 針だけ更新：旧針と新針を囲む矩形だけを転送する
+void drawFuelNeedle(int level) {
+    level = constrain(level, 0, 100);
+    if (fuelShownLevel < 0 || !fuelDialValid || fuelDialColor != meterColor) {
+        drawFuelMeter(level);
+        return;
+    }
+    if (level == fuelShownLevel) return;
+
+    composeFuelCanvas(level);
+
+    // 軸キャップ(半径3)と線幅の余白込みで外接矩形
+    int x0 = min(0, (int)min(fuelTipDx[level], fuelTipDx[fuelShownLevel])) - 4;
+    int x1 = max(0, (int)max(fuelTipDx[level], fuelTipDx[fuelShownLevel])) + 4;
+    int y0 = min(0, (int)min(fuelTipDy[level], fuelTipDy[fuelShownLevel])) - 4;
+    int y1 = max(0, (int)max(fuelTipDy[level], fuelTipDy[fuelShownLevel])) + 4;
+
+    M5.Display.setClipRect(FUEL_CX + x0, FUEL_CY + y0, x1 - x0 + 1, y1 - y0 + 1);
+    fuelCanvas.pushSprite(FUEL_AREA_X, FUEL_AREA_Y);
+    M5.Display.clearClipRect();
+
+    fuelShownLevel = level;
 }
 
 static int  lastFuelLevel = -1;
@@ -2289,7 +3360,7 @@ void updateFuelMeter() {
     // ---- Fuelバー更新（差分のみ）----
     if (level != lastFuelLevel) {
         lastFuelLevel = level;
-        drawFuelMeter(level);
+        drawFuelNeedle(level);
     }
 
     // ---- アイコン更新（状態変化時のみ）----
@@ -2405,7 +3476,7 @@ void updatePomodoro() {
     // ==== 🔸描画はメーターモードのときのみ ====
     if (displayMode == MODE_METER){
         if (millis() - lastFuelDraw > 200) {
-            drawFuelMeter(newLevel);
+            drawFuelNeedle(newLevel);
             lastFuelDraw = millis();
         }
 
@@ -2557,7 +3628,6 @@ void registerActivity() {
     lastActivityTime = millis();
     if (screenSaverActive) {
         screenSaverActive = false;
-        M5.Display.fillScreen(BLACK);
         drawMeterBackground();
         drawFuelMeter(getFuelPercent());
     }
@@ -3680,20 +4750,30 @@ void receiveEvent(int bytes) {
         uint8_t high = Wire.read();
         uint8_t low  = Wire.read();
         uint16_t newValue = (high << 8) | low;
-        applyCPM(newValue);
-        activeSource = SRC_I2C;
+        onSourceCPM(SRC_I2C, newValue);
+        countSourcePacket(SRC_I2C);
         // Serial.printf("I2C Received CPM=%d\n", newValue);
     }
     else if (cmd == 0x02 && bytes >= 1) {
         uint8_t layer = Wire.read();
-        applyLayer(layer);
-        activeSource = SRC_I2C;
+        onSourceLayer(SRC_I2C, layer);
+        countSourcePacket(SRC_I2C);
         // Serial.printf("I2C Received Layer=%d\n", layer);
     }
 
+    else if (cmd == PCX_HEADER) {
+        static PcxAssembler i2cPcx;
+        pcxBegin(i2cPcx);
+        while (Wire.available()) {
+            if (pcxFeed(i2cPcx, Wire.read())) break;
+        }
+        countSourcePacket(SRC_I2C);
+    }
+
     else if (cmd >= 0x20 && bytes >= 1) {
         uint8_t v = Wire.read();
         applyPCStatus(cmd, v);
+        countSourcePacket(SRC_I2C);
     }
 }
 
@@ -3706,11 +4786,13 @@ static uint8_t usb_lsb   = 0;
 static uint8_t usb_msb   = 0;
 
 static int8_t usb_mouse_dx = 0;
+static PcxAssembler usbPcx;
 
 void processUSBSerial() {
 
     while (Serial.available() > 0) {
         uint8_t b = Serial.read();
+        uint8_t prevState = usb_state;
 
         // Serial.printf("[RAW] %02X \n", b);
 
@@ -3739,10 +4821,14 @@ void processUSBSerial() {
                 // wheel
                 usb_state = 23;
             }
-            else if (b >= 0x20 && b <= 0x26) {
+            else if (b >= 0x20 && b <= 0x27) {
                 usb_state = 10;
                 lastCmd = b;
             }
+            else if (b == PCX_HEADER) {
+                pcxBegin(usbPcx);
+                usb_state = 30;
+            }
             break;
 
         // ---- CPM LSB ----
@@ -3756,16 +4842,14 @@ void processUSBSerial() {
             usb_msb = b;
             {
                 uint16_t cpm = (usb_msb << 8) | usb_lsb;
-                applyCPM(cpm);
-                activeSource = SRC_USB;
+                onSourceCPM(SRC_USB, cpm);
             }
             usb_state = 0;
             break;
 
         // ---- Layer ----
         case 3:
-            applyLayer(b);
-            activeSource = SRC_USB;
+            onSourceLayer(SRC_USB, b);
             usb_state = 0;
             break;
         
@@ -3805,6 +4889,13 @@ case 20:
             usb_state = 0;
             break;
         
+        case 30:
+            // 拡張PCステータス
+            if (pcxFeed(usbPcx, b)) {
+                usb_state = 0;
+            }
+            break;
+
         case 100:
             if (b == 0x00) {
                 sendDeviceId();
@@ -3816,6 +4907,11 @@ case 20:
             usb_state = 0;
             break;
         }
+
+        // ペイロードを読み切ってヘッダ待ちに戻った = 1 パケット
+        if (prevState != 0 && usb_state == 0) {
+            countSourcePacket(SRC_USB);
+        }
     }
 }
 
@@ -3823,32 +4919,58 @@ case 20:
 
 
 // ==== Bluetooth Serial からの受信処理（超・非ブロッキング） ====
+static PcxAssembler btPcx;
+static bool btInPcx = false;
+
 void processBTSerial() {
     if (!SerialBT.hasClient()) return;
 
     while (SerialBT.available() > 0) {
+        // 拡張PCステータスは途中で途切れても次回続きから読む
+        if (btInPcx) {
+            if (pcxFeed(btPcx, SerialBT.read())) {
+                btInPcx = false;
+                countSourcePacket(SRC_BT);
+            }
+            continue;
+        }
+
         int cmd = SerialBT.read();
 
+        // HELLO → DEVICE_ID（BT 側でも拡張フレーム対応を通知する）
+        if (cmd == 0xF0) {
+            if (SerialBT.available() < 1) return;
+            if (SerialBT.read() == 0x00) sendDeviceId(SerialBT);
+            continue;
+        }
+
+        if (cmd == PCX_HEADER) {
+            pcxBegin(btPcx);
+            btInPcx = true;
+            continue;
+        }
+
         if (cmd == 0x01) {
             if (SerialBT.available() < 2) return;
             uint8_t lsb = SerialBT.read();
             uint8_t msb = SerialBT.read();
             uint16_t cpm = (static_cast<uint16_t>(msb) << 8) | lsb;
-            applyCPM(cpm);
-            activeSource = SRC_BT;
+            onSourceCPM(SRC_BT, cpm);
+            countSourcePacket(SRC_BT);
         }
 
         else if (cmd == 0x02) {
             if (SerialBT.available() < 1) return;
             uint8_t layer = SerialBT.read();
-            applyLayer(layer);
-            activeSource = SRC_BT;
+            onSourceLayer(SRC_BT, layer);
+            countSourcePacket(SRC_BT);
         }
 
-        else if (cmd >= 0x20 && cmd <= 0x26) {
+        else if (cmd >= 0x20 && cmd <= 0x27) {
             if (!SerialBT.available()) return;
             uint8_t v = SerialBT.read();
             applyPCStatus(cmd, v);
+            countSourcePacket(SRC_BT);
         }
         
         else if (cmd == 0x31) {
@@ -3861,6 +4983,7 @@ void processBTSerial() {
                 static_cast<int8_t>(SerialBT.read());
 
             applyHudMouseMotion(dx, dy);
+            countSourcePacket(SRC_BT);
         }
 
         else if (cmd == 0x32) {
@@ -3868,6 +4991,7 @@ void processBTSerial() {
 
             uint8_t button = SerialBT.read();
             applyHudMouseClick(button);
+            countSourcePacket(SRC_BT);
         }
 
         else if (cmd == 0x33) {
@@ -3877,6 +5001,7 @@ void processBTSerial() {
                 static_cast<int8_t>(SerialBT.read());
 
             applyHudScroll(wheel);
+            countSourcePacket(SRC_BT);
         }
     }
 }
@@ -4139,36 +5264,187 @@ void updateBatteryUI() {
   }
 }
 
+// ==== DEMO シミュレーション ====
+// xorshift32：シードが同じならステップ列も同じ
+uint32_t simRand() {
+    simRng ^= simRng << 13;
+    simRng ^= simRng >> 17;
+    simRng ^= simRng << 5;
+    return simRng;
+}
+
+// [lo, hi] の一様整数
+int simRandRange(int lo, int hi) {
+    return lo + (int)(simRand() % (uint32_t)(hi - lo + 1));
+}
+
+// プロファイル開始：乱数を (シード, プロファイル) で初期化して再現性を保つ
+void simBeginProfile(SimProfile p) {
+    simProfile = p;
+    simStep    = 0;
+    simRng     = SIM_SEED ^ ((uint32_t)p * 0x9E3779B9u);
+    if (simRng == 0) simRng = SIM_SEED;
+    memset(&simStats[p], 0, sizeof(SimStats));
+    simPrevLoopUs = 0;     // 前回の実行・プロファイルの間隔を持ち越さない
+    Serial.printf("[SIM] start %s seed=%08lX\n",
+                  SIM_PROFILE_NAMES[p], (unsigned long)SIM_SEED);
+}
+
+void simReportProfile(SimProfile p) {
+    const SimStats& st = simStats[p];
+    uint32_t avg = st.frames ? (uint32_t)(st.frameSumUs / st.frames) : 0;
+    Serial.printf("[SIM] %-7s frames=%lu events=%lu frameAvg=%luus frameMax=%luus loopMax=%luus tickDrop=%lu tickLate=%lu logGraph=%lu/%luus\n",
+                  SIM_PROFILE_NAMES[p],
+                  (unsigned long)st.frames, (unsigned long)st.events,
+                  (unsigned long)avg, (unsigned long)st.frameMaxUs,
+                  (unsigned long)st.loopMaxUs,
+                  (unsigned long)tickDropped, (unsigned long)tickLate,
+                  (unsigned long)logGraphRenderUs, (unsigned long)st.logGraphMaxUs);
+    Serial.printf("[SIM] %-7s glass pace=%c fps=%u\n",
+                  SIM_PROFILE_NAMES[p],
+                  GLASS_PACE_LABEL[glassPaceState], glassReticleFps);
+}
+
+// 従来デモ：200ms ごとにサイン波＋ノイズ
+void simStepClassic(uint32_t step) {
+    if (step % 20 != 0) return;
+    int phase = step / 20;
+
+    int base = 600 + 400 * sin(phase * 0.05f);
+    applyCPM(constrain(base + simRandRange(-80, 79), 0, VALUE_MAX));
+
+    pc_cpu  = constrain(40 + 30 * sin(phase * 0.03f), 0, 100);
+    pc_ram  = constrain(55 + 25 * sin(phase * 0.02f + 1.0f), 0, 100);
+    pc_disk = constrain(20 + 60 * abs(sin(phase * 0.015f)), 0, 100);
+
+    pc_disk_r_level = simRandRange(0, 5);
+    pc_disk_W_level = simRandRange(0, 5);
+    pc_disk_r_mbps  = pc_disk_r_level * simRandRange(5, 19) / 10.0f;
+    pc_disk_w_mbps  = pc_disk_W_level * simRandRange(3, 14) / 10.0f;
+
+    if (phase % 20 == 0) applyLayer((phase / 20) % 5);
+    simStats[SIM_CLASSIC].events++;
+}
+
+// 2000CPM 付近のバースト 3秒 → 無打鍵 1秒 を繰り返す（CPM は 50ms 間隔で届く想定）
+void simStepBurst(uint32_t step) {
+    uint32_t t = step % 400;
+    if (t < 300) {
+        if (t % 5 == 0) {
+            applyCPM(simRandRange(1850, VALUE_MAX));
+            simStats[SIM_BURST_TYPING].events++;
+        }
+    } else if (t % 10 == 0) {
+        applyCPM(0);
+        simStats[SIM_BURST_TYPING].events++;
+    }
+}
+
+// 10ms ごとにレイヤー変更＋打鍵継続
+void simStepLayerThrash(uint32_t step) {
+    applyLayer(simRandRange(0, 4));
+    simStats[SIM_LAYER_THRASH].events++;
+    if (step % 5 == 0) {
+        applyCPM(simRandRange(300, 900));
+        simStats[SIM_LAYER_THRASH].events++;
+    }
+}
+
+// 100Hz マウス移動 + 時々クリック / ホイール
+void simStepMouseHud(uint32_t step) {
+    applyHudMouseMotion(simRandRange(-12, 12), simRandRange(-12, 12));
+    simStats[SIM_MOUSE_HUD].events++;
+
+    uint32_t r = simRand() % 100;
+    if (r < 3) {
+        applyHudMouseClick(HUD_BUTTON_LEFT);
+        simStats[SIM_MOUSE_HUD].events++;
+    } else if (r < 8) {
+        applyHudScroll(simRandRange(-3, 3));
+        simStats[SIM_MOUSE_HUD].events++;
+    }
+}
+
+// 10ms ごとに 0x20〜0x26 を全て異なる値で送り続ける
+void simStepPCStatFlood(uint32_t step) {
+    applyPCStatus(0x20, simRandRange(0, 100));
+    applyPCStatus(0x21, simRandRange(0, 100));
+    applyPCStatus(0x22, simRandRange(0, 100));
+    applyPCStatus(0x23, simRandRange(0, 5));
+    applyPCStatus(0x24, simRandRange(0, 5));
+    applyPCStatus(0x25, simRandRange(0, 255));
+    applyPCStatus(0x26, simRandRange(0, 255));
+    simStats[SIM_PCSTAT_FLOOD].events += 7;
+
+    // 100ms ごとに拡張フレームも 1 本流す（8コア＋温度2＋ネット）
+    if (step % 10 != 0) return;
+    uint8_t f[64];
+    uint8_t n = 0;
+    auto put16 = [&](uint16_t v) { f[n++] = v & 0xFF; f[n++] = v >> 8; };
+    f[n++] = 0x01; f[n++] = 2; put16(simRandRange(0, 1000));
+    f[n++] = 0x06; f[n++] = 16;
+    for (int i = 0; i < 8; i++) put16(simRandRange(0, 1000));
+    f[n++] = 0x07; f[n++] = 4; put16(simRandRange(350, 900)); put16(simRandRange(300, 700));
+    f[n++] = 0x08; f[n++] = 2; put16(simRandRange(0, 12000));
+    f[n++] = 0x09; f[n++] = 2; put16(simRandRange(0, 3000));
+
+    uint8_t sum = PCX_VERSION + n;
+    for (uint8_t i = 0; i < n; i++) sum += f[i];
+
+    static PcxAssembler simPcx;
+    pcxBegin(simPcx);
+    pcxFeed(simPcx, PCX_VERSION);
+    pcxFeed(simPcx, n);
+    for (uint8_t i = 0; i < n; i++) pcxFeed(simPcx, f[i]);
+    pcxFeed(simPcx, sum);
+    simStats[SIM_PCSTAT_FLOOD].events++;
+}
+
 void updateDemoData() {
     unsigned long now = millis();
-    if (now - lastDemoTick < 200) return;  // 200ms 更新
-    lastDemoTick = now;
+    if (simNextMs == 0) {
+        simNextMs = now;
+        simBeginProfile(SIM_CLASSIC);
+    }
 
-    // ===== CPM（サイン波＋ランダム）
-    int base = 600 + 400 * sin(demoPhase * 0.05f);
-    int noise = random(-80, 80);
-    int demoCPM = constrain(base + noise, 0, VALUE_MAX);
-    applyCPM(demoCPM);
+    // 固定 10ms ステップ。ループが詰まっても追いつきは上限まで
+    uint32_t n = 0;
+    while ((long)(now - simNextMs) >= 0 && n < SIM_MAX_CATCHUP) {
+        simNextMs += SIM_STEP_MS;
+        n++;
+
+        switch (simProfile) {
+            case SIM_CLASSIC:      simStepClassic(simStep);     break;
+            case SIM_BURST_TYPING: simStepBurst(simStep);       break;
+            case SIM_LAYER_THRASH: simStepLayerThrash(simStep); break;
+            case SIM_MOUSE_HUD:    simStepMouseHud(simStep);    break;
+            case SIM_PCSTAT_FLOOD: simStepPCStatFlood(simStep); break;
+            default: break;
+        }
 
-    // ===== PC Status（CPU / RAM / DISK）
-    pc_cpu  = constrain(40 + 30 * sin(demoPhase * 0.03f), 0, 100);
-    pc_ram  = constrain(55 + 25 * sin(demoPhase * 0.02f + 1.0f), 0, 100);
-    pc_disk = constrain(20 + 60 * abs(sin(demoPhase * 0.015f)), 0, 100);
+        if (++simStep >= SIM_PROFILE_STEPS) {
+            simReportProfile(simProfile);
+            simBeginProfile((SimProfile)((simProfile + 1) % SIM_PROFILE_COUNT));
+        }
+    }
+    // 追いつけなかった分は捨てる（時間基準を現在に合わせる）
+    if ((long)(now - simNextMs) >= 0) simNextMs = now + SIM_STEP_MS;
+}
 
-    // ===== Disk R/W アクティビティ（0〜5）
-    pc_disk_r_level = random(0, 6);
-    pc_disk_W_level = random(0, 6);
+// loop 1回分の計測値を現在のプロファイルに加算
+void simRecordLoop(uint32_t startUs, uint32_t endUs) {
+    SimStats& st = simStats[simProfile];
 
-    // ===== Disk MB/s（バーとは独立）
-    pc_disk_r_mbps = pc_disk_r_level * random(5, 20) / 10.0f;
-    pc_disk_w_mbps = pc_disk_W_level * random(3, 15) / 10.0f;
+    uint32_t frameUs = endUs - startUs;
+    st.frames++;
+    st.frameSumUs += frameUs;
+    if (frameUs > st.frameMaxUs) st.frameMaxUs = frameUs;
 
-    // ===== レイヤー（0〜4 ローテーション）
-    if (demoPhase % 20 == 0) {
-        applyLayer((demoPhase / 20) % 5);
+    if (simPrevLoopUs != 0) {
+        uint32_t gapUs = startUs - simPrevLoopUs;
+        if (gapUs > st.loopMaxUs) st.loopMaxUs = gapUs;
     }
-
-    demoPhase++;
+    simPrevLoopUs = startUs;
 }
 
 
@@ -4197,6 +5473,9 @@ void setup() {
     //画面輝度最大
     M5.Lcd.setBrightness(255);
 
+    // グラフ用 CPM パレット
+    buildCPMPalette();
+
     Wire.begin(32, 33);
     glass.begin();
     glass.clear();
@@ -4268,6 +5547,10 @@ void setup() {
     colorIndex = prefs.getInt("meterColorIdx", 0);
     meterColor = METER_COLORS[colorIndex];
 
+    // 入力ソース調停ポリシー
+    arbPolicy = (ArbPolicy)prefs.getUChar("arbPolicy", ARB_MOST_RECENT);
+    if (arbPolicy >= ARB_POLICY_COUNT) arbPolicy = ARB_MOST_RECENT;
+
     M5.Display.clearDisplay(TFT_BLACK);
     if (hudMirror) {
         M5.Display.setRotation(7);   // ミラー
@@ -4289,11 +5572,25 @@ void setup() {
     drawMeterBackground();
     drawFuelMeter(getFuelPercent());
     drawShiftIndicator();
+
+    // 1秒ティック開始
+    lastTickMs = millis();
+    startCpmTickTimer();
   
 }
 
 // ==== メインループ ====
+void runMainLoop();
+
 void loop() {
+    uint32_t startUs = micros();
+    runMainLoop();
+    if (appMode == MODE_DEMO) {
+        simRecordLoop(startUs, micros());
+    }
+}
+
+void runMainLoop() {
     M5.update();
 
 
@@ -4325,6 +5622,19 @@ void loop() {
                     lastActivityTime = millis();
                 }
             }
+
+            // PC STATUS 最下段：入力ソース調停ポリシー切替
+            if (displayMode == MODE_PCSTAT && !screenSaverActive &&
+                touch.y >= 215 && touch.y < 240) {
+                cycleArbPolicy();
+            }
+
+            // PC STATUS タイトル帯（GLASS切替域以外）：ページ切替
+            if (displayMode == MODE_PCSTAT && !screenSaverActive &&
+                touch.y <= 40 && (touch.x < 130 || touch.x > 190)) {
+                pcStatPage = (pcStatPage + 1) % PC_STAT_PAGES;
+                drawPCStatusScreen();
+            }
         }
     }
 
@@ -4336,11 +5646,7 @@ void loop() {
         drawBatteryIndicator();
     }
     
-    unsigned long now = millis();
-    if (now - lastTickMs >= 1000) {
-            lastTickMs += 1000;
-            onSecondTick();//Global 1-second tick
-        }
+    drainCpmTicks();   //Global 1-second tick（esp_timer 標本）
 
  // ==== DEMO モード処理 ====
 if (appMode == MODE_DEMO) {
@@ -4359,6 +5665,7 @@ if (appMode == MODE_USB_BT) {
     processUSBSerial();
     processBTSerial();
 }
+updateSourceRates();
 
 static uint8_t prevSource = 255;
 if (prevSource != activeSource) {
@@ -4396,7 +5703,14 @@ if (millis() - lastGlassUpdateMs >= glassInterval) {
 
 //PCstatus自動更新
 
-if (displayMode == MODE_PCSTAT && !screenSaverActive) {
+if (displayMode == MODE_PCSTAT && !screenSaverActive && pcStatPage == 1) {
+    updatePCStatusExtScreen();
+    if (sourceRatesDirty) {
+        drawSourceRates();
+    }
+}
+
+if (displayMode == MODE_PCSTAT && !screenSaverActive && pcStatPage == 0) {
    
     if (pc_cpu != last_cpu) {
     updateBar("CPU:", pc_cpu, 60);
@@ -4440,6 +5754,12 @@ if (displayMode == MODE_PCSTAT && !screenSaverActive) {
         drawFloatValueText(260, 200, pc_disk_w_mbps);
         last_disk_w_mbps = pc_disk_w_mbps;
     }
+
+    if (sourceRatesDirty) {
+        drawSourceRates();
+    }
+
+    updatePCSparklines();
 }
 
 
@@ -4601,7 +5921,7 @@ if (M5.BtnC.pressedFor(2000)) {
                                         MODE_METER;
 
         displayMode = nextMode;  // モードを更新
-        M5.Display.fillScreen(BLACK); // 必ず一度クリア
+        // 各画面の背景は全面転送なのでクリア不要
 
         if (nextMode == MODE_LOG) {
             drawLogScreen();  // Logモード用描画のみ
@@ -4679,7 +5999,6 @@ if (touchPressed && (touchX > 80 && touchX < 240 && touchY > 80 && touchY < 200)
         } else {
             // === 🔹 OFF → 通常メータ画面へ復帰 ===
             displayMode = MODE_METER;
-            M5.Display.fillScreen(BLACK);
             drawMeterBackground();
             drawFuelMeter(getFuelPercent());
             updateRed();
@@ -4752,8 +6071,6 @@ if (screenSaverActive) {
         // ★ 保存しておいたモードに戻す
         displayMode = prevDisplayMode;
 
-        M5.Display.fillScreen(BLACK);
-
         if (displayMode == MODE_METER) {
             drawMeterBackground();
             drawFuelMeter(getFuelPercent());